@@ -0,0 +1,119 @@
+/*
+    nanogui/arena.h -- Pool allocator for widgets and other objects
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <mutex>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class Arena arena.h nanogui/arena.h
+ *
+ * \brief Pool allocator for \ref Object instances.
+ *
+ * Objects created with \c new while an \ref Arena::Scope is active on the
+ * current thread are allocated from the slabs of the arena instead of the
+ * heap (see \ref Object::operator new). Allocations are grouped into size
+ * classes of 16 bytes, hence all widgets of the same class share a pool,
+ * and widgets created together end up next to each other in memory.
+ * Released blocks are recycled for objects of the same size class.
+ *
+ * Every allocation holds a reference to its arena. Once the last object
+ * is released and the arena is no longer referenced otherwise, all slabs
+ * are freed at once; using a separate arena for the widgets of a window
+ * therefore releases their memory in bulk when the window is disposed.
+ *
+ * Slabs are aligned to \ref slab_alignment and registered in a process-wide
+ * table, so that \ref owner() finds the arena of an object from its
+ * address. Objects therefore need no per-allocation header, and objects
+ * allocated while no arena exists pay only for an atomic load on deletion.
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    {
+ *        Arena::Scope scope(screen->arena());
+ *        Window *window = new Window(screen, "Channels");
+ *        // [ ... widgets created here are allocated from the arena ... ]
+ *    }
+ *
+ * \endrst
+ */
+class NANOGUI_EXPORT Arena : public Object {
+public:
+    /// Size of the largest allocation served from the slabs (larger ones use the heap)
+    static constexpr size_t max_block_size = 2048;
+    /// Alignment and size granularity of the allocations
+    static constexpr size_t granularity = 16;
+    /// Alignment of the slabs (slab sizes are rounded up to a multiple)
+    static constexpr size_t slab_alignment = 64 * 1024;
+
+    /// Create an arena that allocates slabs of the given size
+    Arena(size_t slab_size = slab_alignment);
+
+    /// Allocate a block of at least \c size bytes (at most \ref max_block_size)
+    void *allocate(size_t size);
+
+    /// Release a block previously returned by \ref allocate() with the same size
+    void deallocate(void *ptr, size_t size) noexcept;
+
+    /// Return the arena whose slabs contain the given address (or \c nullptr)
+    static Arena *owner(const void *ptr) noexcept;
+
+    /// Return the number of bytes in blocks that are currently allocated
+    size_t allocated() const { return m_allocated; }
+
+    /// Return the number of bytes reserved in slabs
+    size_t reserved() const { return m_slabs.size() * m_slab_size; }
+
+    /// Return the arena used by the current thread to allocate objects (if any)
+    static Arena *current();
+
+    /**
+     * \class Scope arena.h nanogui/arena.h
+     *
+     * \brief Allocate the objects created on the current thread from an
+     * arena while the scope is active (scopes may be nested).
+     */
+    class NANOGUI_EXPORT Scope {
+    public:
+        Scope(Arena *arena);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    protected:
+        ref<Arena> m_arena;
+        Arena *m_previous;
+    };
+
+protected:
+    virtual ~Arena();
+
+    static size_t size_class(size_t size) { return (size + granularity - 1) / granularity; }
+
+protected:
+    size_t m_slab_size;
+    std::vector<char *> m_slabs;
+    /// Unused space at the end of the current slab
+    char *m_next = nullptr, *m_end = nullptr;
+    /// Intrusive lists of released blocks, by size class
+    void *m_free[max_block_size / granularity + 1] = { };
+    size_t m_allocated = 0;
+    std::mutex m_mutex;
+};
+
+NAMESPACE_END(nanogui)
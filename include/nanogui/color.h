@@ -120,6 +120,11 @@ public:
         return Color(luminance < 0.5f ? 1.f : 0.f, 1.f);
     }
 
+    /// Check whether two colors have the same components
+    bool operator==(const Color &c) const { return m_rgba == c.m_rgba; }
+    /// Check whether two colors differ in any component
+    bool operator!=(const Color &c) const { return m_rgba != c.m_rgba; }
+
     /// Allows for conversion between this Color and NanoVG's representation.
     operator const NVGcolor &() const {
         return reinterpret_cast<const NVGcolor &>(*m_rgba.data());
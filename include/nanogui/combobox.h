@@ -22,6 +22,20 @@ NAMESPACE_BEGIN(nanogui)
  * \class ComboBox combobox.h nanogui/combobox.h
  *
  * \brief Simple combo box widget based on a popup button.
+ *
+ * The popup draws the items directly from the item list and only visits the
+ * rows that are visible, hence opening it takes the same time for a handful
+ * of items as for tens of thousands. When there are more items than visible
+ * rows, typing while the popup is open shows only the items starting with
+ * the typed text (ignoring case). The filter uses a sorted index of the
+ * lower-case items built by \ref set_items(), so that each keystroke is a
+ * binary search.
+ *
+ * \remark
+ *     The popup no longer contains a \ref VScrollPanel with one \ref Button
+ *     per item, and the protected members ``m_scroll`` and ``m_container``
+ *     were removed. Subclasses that styled or extended those buttons must
+ *     draw the rows themselves (see ``ComboBox::List`` in combobox.cpp).
  */
 class NANOGUI_EXPORT ComboBox : public PopupButton {
 public:
@@ -59,14 +73,35 @@ public:
     /// The short descriptions associated with this ComboBox.
     const std::vector<std::string> &items_short() const { return m_items_short; }
 
+    /// The maximum number of rows shown by the popup at once.
+    int visible_rows() const { return m_visible_rows; }
+    /// Sets the maximum number of rows shown by the popup at once (requires a new layout).
+    void set_visible_rows(int rows) { m_visible_rows = rows; }
+
+    /// Whether the popup shows a filter field (if there are more items than visible rows).
+    bool searchable() const { return (int) m_items.size() > m_visible_rows; }
+    /// The text that the items shown by the popup start with.
+    const std::string &filter() const { return m_filter; }
+    /// Only show the items starting with the given text (ignoring case) in the popup.
+    void set_filter(const std::string &filter);
+    /// The number of items shown by the popup with the current filter.
+    size_t match_count() const { return m_match_end - m_match_begin; }
+
+    /// Handles mouse clicks (and opens the popup) for this ComboBox.
+    virtual bool mouse_button_event(const Vector2i &p, int button, bool down, int modifiers) override;
     /// Handles mouse scrolling events for this ComboBox.
     virtual bool scroll_event(const Vector2i &p, const Vector2f &rel) override;
 protected:
-    /// Scroll panel used to store the combo box contents
-    VScrollPanel *m_scroll = nullptr;
+    /// Return the index of the item shown in the given row of the popup.
+    int row_item(size_t row) const {
+        return m_filter.empty() ? (int) row : m_sorted[m_match_begin + row];
+    }
+    /// Select an item picked from the popup, close it and notify the callback.
+    void choose(int index);
 
-    /// Container containing the buttons
-    Widget *m_container = nullptr;
+    /// Widget drawing the rows of the popup (defined in combobox.cpp)
+    class List;
+    List *m_list = nullptr;
 
     /// The items associated with this ComboBox.
     std::vector<std::string> m_items;
@@ -79,6 +114,15 @@ protected:
 
     /// The current index this ComboBox has selected.
     int m_selected_index;
+
+    /// Lower-case items in lexicographic order (the index used by the filter).
+    std::vector<std::string> m_keys;
+    /// The item index corresponding to each entry of \ref m_keys.
+    std::vector<int> m_sorted;
+    /// Range of \ref m_keys starting with the filter.
+    size_t m_match_begin = 0, m_match_end = 0;
+    std::string m_filter;
+    int m_visible_rows = 10;
 };
 
 NAMESPACE_END(nanogui)
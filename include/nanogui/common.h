@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <array>
 #include <vector>
+#include <functional>
 
 /* Set to 1 to draw boxes around widgets */
 //#define NANOGUI_SHOW_WIDGET_BOUNDS 1
@@ -233,6 +234,32 @@ extern NANOGUI_EXPORT void leave();
 /// Return whether or not a main loop is currently active
 extern NANOGUI_EXPORT bool active();
 
+/**
+ * \brief Let \ref mainloop() draw every \ref Screen on its own render thread
+ *
+ * By default, the main loop draws the screens one after another, hence
+ * screens synchronizing with the vertical blank of their monitor wait for
+ * each other. When enabled, the main loop calls
+ * \ref Screen::set_threaded_rendering() for every screen while it runs, and
+ * only handles events itself. Disabled by default.
+ */
+extern NANOGUI_EXPORT void set_render_threads(bool value);
+
+/// Does \ref mainloop() draw every \ref Screen on its own render thread?
+extern NANOGUI_EXPORT bool render_threads();
+
+/**
+ * \brief Run a function on the main thread during the next iteration of
+ * \ref mainloop()
+ *
+ * May be called from any thread, and wakes up the main loop if it is waiting
+ * for events. The functions run in the order in which they were submitted,
+ * before the screens are drawn, while holding \ref Screen::ui_mutex() of
+ * every screen; all screens are redrawn afterwards. See \ref Screen::post()
+ * for updates that only concern a single screen.
+ */
+extern NANOGUI_EXPORT void async_ui(const std::function<void()> &func);
+
 /**
  * \brief Open a native file open/save dialog.
  *
@@ -290,13 +317,20 @@ extern NANOGUI_EXPORT void chdir_to_bundle_parent();
  */
 extern NANOGUI_EXPORT std::array<char, 8> utf8(int c);
 
-/// Load a directory of PNG images and upload them to the GPU (suitable for use with ImagePanel)
+/**
+ * \brief Load a directory of PNG images and upload them to the GPU (suitable
+ * for use with ImagePanel)
+ *
+ * The images are managed by the \ref ImageCache of the context: loading the
+ * same directory again returns the cached images. They are never evicted,
+ * hence the returned handles remain valid.
+ */
 extern NANOGUI_EXPORT std::vector<std::pair<int, std::string>>
     load_image_directory(NVGcontext *ctx, const std::string &path);
 
-/// Convenience function for instanting a PNG icon from the application's data segment (via bin2c)
+/// Convenience function for instanting a PNG icon from the application's data segment (via resources/embed.cmake)
 #define nvg_image_icon(ctx, name) nanogui::__nanogui_get_image(ctx, #name, name##_png, name##_png_size)
-/// Helper function used by nvg_image_icon
+/// Helper function used by nvg_image_icon (the image is held by the context's \ref ImageCache)
 extern NANOGUI_EXPORT int __nanogui_get_image(NVGcontext *ctx, const std::string &name, uint8_t *data, uint32_t size);
 
 NAMESPACE_END(nanogui)
@@ -86,6 +86,8 @@ NAMESPACE_BEGIN(detail)
 template <typename T, typename sfinae = std::true_type> class FormWidget { };
 NAMESPACE_END(detail)
 
+template <typename Type> class Property;
+
 /**
  * \class FormHelper formhelper.h nanogui/formhelper.h
  *
@@ -126,6 +128,20 @@ public:
     /// Create a helper class to construct NanoGUI widgets on the given screen
     FormHelper(Screen *screen) : m_screen(screen) { }
 
+    /// Unbind all properties observed by this form and disconnect their widgets
+    ~FormHelper() {
+        for (auto &observer : m_observers) {
+            /* The widgets may outlive the form and the properties */
+            if (observer.release)
+                observer.release();
+            if (observer.detach)
+                observer.detach();
+        }
+    }
+
+    FormHelper(const FormHelper &) = delete;
+    FormHelper &operator=(const FormHelper &) = delete;
+
     /// Add a new top-level window
     Window *add_window(const Vector2i &pos,
                          const std::string &title = "Untitled") {
@@ -151,30 +167,29 @@ public:
         return label;
     }
 
-    /// Add a new data widget controlled using custom getter/setter functions
+    /**
+     * \brief Add a new data widget controlled using custom getter/setter functions
+     *
+     * \ref refresh() calls the getter and only updates the widget when the
+     * returned value differs from the last value shown by the widget.
+     */
     template <typename Type> detail::FormWidget<Type> *
     add_variable(const std::string &label, const std::function<void(const Type &)> &setter,
                 const std::function<Type()> &getter, bool editable = true) {
-        Label *label_w = new Label(m_window, label, m_label_font_name, m_label_font_size);
-        auto widget = new detail::FormWidget<Type>(m_window);
-        auto refresh = [widget, getter] {
-            Type value = getter(), current = widget->value();
-            if (value != current)
+        auto widget = add_variable_widget<Type>(label, editable);
+        auto last = std::make_shared<Type>(getter());
+        widget->set_value(*last);
+        widget->set_callback([setter, last](const Type &value) {
+            *last = value;
+            setter(value);
+        });
+        m_refresh_callbacks.push_back([widget, getter, last] {
+            Type value = getter();
+            if (value != *last) {
                 widget->set_value(value);
-        };
-        refresh();
-        widget->set_callback(setter);
-        widget->set_editable(editable);
-        widget->set_font_size(m_widget_font_size);
-        Vector2i fs = widget->fixed_size();
-        widget->set_fixed_size(Vector2i(fs.x() != 0 ? fs.x() : m_fixed_size.x(),
-                                      fs.y() != 0 ? fs.y() : m_fixed_size.y()));
-        m_refresh_callbacks.push_back(refresh);
-        if (m_layout->row_count() > 0)
-            m_layout->append_row(m_variable_spacing);
-        m_layout->append_row(0);
-        m_layout->set_anchor(label_w, AdvancedGridLayout::Anchor(1, m_layout->row_count()-1));
-        m_layout->set_anchor(widget, AdvancedGridLayout::Anchor(3, m_layout->row_count()-1));
+                *last = std::move(value);
+            }
+        });
         return widget;
     }
 
@@ -188,6 +203,36 @@ public:
         );
     }
 
+    /**
+     * \brief Add a new data widget that observes a \ref Property
+     *
+     * Instead of being polled by \ref refresh(), the property notifies the
+     * form when its value changes, and \ref refresh() only updates the
+     * widgets of the properties that changed. A property can be bound to a
+     * single form at a time.
+     */
+    template <typename Type> detail::FormWidget<Type> *
+    add_variable(const std::string &label, Property<Type> &property, bool editable = true) {
+        if (property.m_form)
+            throw std::runtime_error(
+                "FormHelper::add_variable(): property is already bound to a form!");
+        auto widget = add_variable_widget<Type>(label, editable);
+        widget->set_value(property.m_value);
+        /* The widget already shows values entered by the user */
+        widget->set_callback([&property](const Type &value) { property.m_value = value; });
+        property.m_form = this;
+        property.m_index = m_observers.size();
+        /* Keep the widget alive: its window may be disposed before the form
+           or the property, which must still disconnect it afterwards */
+        ref<detail::FormWidget<Type>> widget_ref(widget);
+        m_observers.push_back({
+            [widget_ref, &property]() mutable { widget_ref->set_value(property.m_value); },
+            [&property] { property.m_form = nullptr; },
+            [widget_ref]() mutable { widget_ref->set_callback([](const Type &) { }); }
+        });
+        return widget;
+    }
+
     /// Add a button with a custom callback
     Button *add_button(const std::string &label, const std::function<void()> &cb) {
         Button *button = new Button(m_window, label);
@@ -216,6 +261,13 @@ public:
     void refresh() {
         for (auto const &callback : m_refresh_callbacks)
             callback();
+        for (size_t index : m_dirty) {
+            Observer &observer = m_observers[index];
+            observer.dirty = false;
+            if (observer.update)
+                observer.update();
+        }
+        m_dirty.clear();
     }
 
     /// Access the currently active \ref Window instance
@@ -266,6 +318,54 @@ public:
     /// Sets the size of the font being used for non-group / non-label widgets.
     void set_widget_font_size(int value) { m_widget_font_size = value; }
 
+protected:
+    template <typename Type> friend class Property;
+
+    /// Create the label and widget of a new variable
+    template <typename Type> detail::FormWidget<Type> *
+    add_variable_widget(const std::string &label, bool editable) {
+        Label *label_w = new Label(m_window, label, m_label_font_name, m_label_font_size);
+        auto widget = new detail::FormWidget<Type>(m_window);
+        widget->set_editable(editable);
+        widget->set_font_size(m_widget_font_size);
+        Vector2i fs = widget->fixed_size();
+        widget->set_fixed_size(Vector2i(fs.x() != 0 ? fs.x() : m_fixed_size.x(),
+                                      fs.y() != 0 ? fs.y() : m_fixed_size.y()));
+        if (m_layout->row_count() > 0)
+            m_layout->append_row(m_variable_spacing);
+        m_layout->append_row(0);
+        m_layout->set_anchor(label_w, AdvancedGridLayout::Anchor(1, m_layout->row_count()-1));
+        m_layout->set_anchor(widget, AdvancedGridLayout::Anchor(3, m_layout->row_count()-1));
+        return widget;
+    }
+
+    /// Called by a bound \ref Property whose value changed
+    void mark_dirty(size_t index) {
+        Observer &observer = m_observers[index];
+        if (!observer.dirty) {
+            observer.dirty = true;
+            m_dirty.push_back(index);
+        }
+    }
+
+    /// Called by a bound \ref Property that is being destroyed
+    void unobserve(size_t index) {
+        Observer &observer = m_observers[index];
+        observer.release();
+        observer = Observer();
+    }
+
+    /// Connection between a bound \ref Property and its widget
+    struct Observer {
+        /// Show the value of the property in the widget
+        std::function<void()> update;
+        /// Unbind the property (when the form is destroyed)
+        std::function<void()> detach;
+        /// Disconnect the widget (when the property or the form is destroyed)
+        std::function<void()> release;
+        bool dirty = false;
+    };
+
 protected:
     /// A reference to the \ref nanogui::Screen this FormHelper is assisting.
     ref<Screen> m_screen;
@@ -275,6 +375,10 @@ protected:
     ref<AdvancedGridLayout> m_layout;
     /// The callbacks associated with all widgets this FormHelper is managing.
     std::vector<std::function<void()>> m_refresh_callbacks;
+    /// The bound properties (indexed by \ref Property::m_index).
+    std::vector<Observer> m_observers;
+    /// The bound properties that changed since the last \ref refresh().
+    std::vector<size_t> m_dirty;
     /// The group header font name.
     std::string m_group_font_name = "sans-bold";
     /// The label font name.
@@ -295,6 +399,73 @@ protected:
     int m_variable_spacing = 5;
 };
 
+/**
+ * \class Property formhelper.h nanogui/formhelper.h
+ *
+ * \brief Variable that notifies the \ref FormHelper it is bound to when its
+ *        value changes.
+ *
+ * Assigning a different value marks the widget of the property for the next
+ * \ref FormHelper::refresh(), which therefore costs time proportional to the
+ * number of changed properties rather than to the size of the form. Values
+ * must be assigned on the thread calling \ref FormHelper::refresh() (use
+ * \ref Screen::post() from other threads).
+ *
+ * **Example**:
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    Property<float> exposure(1.f);
+ *    h->add_variable("exposure", exposure);
+ *
+ *    // [ ... later ... ]
+ *    exposure = 2.f;
+ *    h->refresh();
+ *
+ * \endrst
+ */
+template <typename Type> class Property {
+public:
+    Property(const Type &value = Type()) : m_value(value) { }
+
+    /// Unbind the property from its form
+    ~Property() {
+        if (m_form)
+            m_form->unobserve(m_index);
+    }
+
+    Property(const Property &) = delete;
+    Property &operator=(const Property &) = delete;
+
+    /// Return the current value
+    const Type &value() const { return m_value; }
+    operator const Type &() const { return m_value; }
+
+    /// Set the value and notify the form if it changed
+    void set_value(const Type &value) {
+        if (value != m_value) {
+            m_value = value;
+            if (m_form)
+                m_form->mark_dirty(m_index);
+        }
+    }
+
+    Property &operator=(const Type &value) {
+        set_value(value);
+        return *this;
+    }
+
+protected:
+    friend class FormHelper;
+
+    Type m_value;
+    /// The form the property is bound to (if any)
+    FormHelper *m_form = nullptr;
+    /// Index of the property in \ref FormHelper::m_observers
+    size_t m_index = 0;
+};
+
 NAMESPACE_BEGIN(detail)
 
 /**
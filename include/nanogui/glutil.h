@@ -18,6 +18,11 @@
 #include <enoki/transform.h>
 #include <enoki/quaternion.h>
 #include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 /// Ensures that ``GL_HALF_FLOAT`` and ``GL_DOUBLE`` are defined properly for all platforms.
 #if !defined(GL_HALF_FLOAT) || defined(DOXYGEN_DOCUMENTATION_BUILD)
@@ -109,6 +114,37 @@ public:
               const std::string &fragment_str,
               const std::string &geometry_str = "");
 
+    /**
+     * \brief Submit compilation and linking of the shader without waiting
+     * for the result.
+     *
+     * The arguments are the same as for \ref init(). Compile and link status
+     * queries are deferred until \ref ready() reports completion, which lets
+     * an application submit many programs up front and overlap their
+     * compilation with UI construction. The first call to \ref bind(),
+     * \ref attrib(), or \ref uniform() before that waits for the link to
+     * finish. When the
+     * driver supports ``KHR_parallel_shader_compile`` (or its ARB variant),
+     * the work happens on driver threads; otherwise it proceeds as usual
+     * and the first call to \ref ready() blocks.
+     *
+     * Compilation and linking errors are reported by \ref ready(),
+     * \ref bind(), \ref attrib(), and \ref uniform() by throwing
+     * ``std::runtime_error``.
+     */
+    bool init_async(const std::string &name,
+                    const std::string &vertex_str,
+                    const std::string &fragment_str,
+                    const std::string &geometry_str = "");
+
+    /**
+     * \brief Poll the status of a shader submitted via \ref init_async().
+     *
+     * Returns ``true`` once the program is linked and ready to be bound. This
+     * never blocks when parallel shader compilation is available.
+     */
+    bool ready();
+
     /**
      * \brief Initialize the shader using the specified files on disk.
      *
@@ -143,6 +179,28 @@ public:
         m_definitions[key] = value;
     }
 
+    /**
+     * \brief Enable the on-disk program binary cache (disabled by default).
+     *
+     * When ``path`` refers to an existing directory, \ref init() stores each
+     * successfully linked program there (via ``glGetProgramBinary``) and
+     * reloads it with ``glProgramBinary`` on subsequent runs. The cache key
+     * covers the shader sources, \ref m_definitions and the OpenGL vendor,
+     * renderer, and version strings. Binaries that are missing, truncated,
+     * or rejected by the driver transparently fall back to compiling from
+     * source. Pass an empty string to disable the cache again.
+     *
+     * This requires ``GL_ARB_get_program_binary`` (core in OpenGL 4.1) and is
+     * silently ignored when the driver exposes no binary formats.
+     */
+    static void set_binary_cache_directory(const std::string &path);
+
+    /// Return the on-disk program binary cache directory (empty if disabled)
+    static const std::string &binary_cache_directory();
+
+    /// Was the program loaded from the on-disk binary cache by the last \ref init()?
+    bool loaded_from_binary_cache() const { return m_loaded_from_binary_cache; }
+
     /**
      * Select this shader for subsequent draw calls.  Simply executes ``glUseProgram``
      * with \ref m_program_shader, and ``glBindVertexArray`` with \ref m_vertex_array_object.
@@ -357,6 +415,19 @@ protected:
      * \endrst
      */
     std::map<std::string, std::string> m_definitions;
+
+    /// Was the program loaded from the on-disk binary cache? (see \ref set_binary_cache_directory)
+    bool m_loaded_from_binary_cache = false;
+
+    /// Cache file that receives the program binary once linking completes (if any)
+    std::string m_binary_cache_filename;
+
+    /// Has the program been submitted via \ref init_async() without its status being checked yet?
+    bool m_link_pending = false;
+
+private:
+    /// Wait for a pending link to complete, check for errors, and update the binary cache
+    void finish_link();
 };
 
 //  ----------------------------------------------------
@@ -392,6 +463,12 @@ public:
     /// Return the number of MSAA samples
     int samples() const { return m_samples; }
 
+    /// Return the OpenGL framebuffer handle
+    GLuint framebuffer_id() const { return m_framebuffer; }
+
+    /// Return the size of the framebuffer
+    const Vector2i &size() const { return m_size; }
+
     /// Quick and dirty method to write a TGA (32bpp RGBA) file of the framebuffer contents for debugging
     void download_tga(const std::string &filename);
 protected:
@@ -402,6 +479,180 @@ protected:
 
 //  ----------------------------------------------------
 
+/**
+ * \class GLFrameRecorder glutil.h nanogui/glutil.h
+ *
+ * \brief Asynchronous capture of framebuffer contents to disk or to the
+ * application.
+ *
+ * Frames are read back into a ring of pixel buffer objects guarded by fence
+ * objects, so \ref capture() never waits for the GPU unless every buffer of
+ * the ring is still in flight. Completed frames are handed to worker threads,
+ * which write them as an image sequence or as a raw video stream (32 bit BGRA
+ * frames, bottom row first, concatenated without headers). When the encoders
+ * fall behind by more than \ref max_queued_frames() frames, new frames are
+ * dropped instead of stalling the render loop (see \ref frames_dropped()).
+ *
+ * Alternatively (or additionally), a frame callback receives a pointer to the
+ * mapped buffer without any copies. It runs on the thread that owns the
+ * OpenGL context and must not retain the pointer after returning.
+ *
+ * The recorder requires OpenGL 3.2 (pixel buffer objects and sync objects)
+ * and is not available on GLES2.
+ *
+ * \rst
+ * .. code-block:: cpp
+ *
+ *    GLFrameRecorder recorder;
+ *    recorder.init(framebuffer_size);
+ *    recorder.start_sequence("frame_%05i.tga", GLFrameRecorder::Format::TGA);
+ *
+ *    // .. after drawing each frame, before swapping buffers ..
+ *    recorder.capture();
+ *
+ *    // .. when done ..
+ *    recorder.stop();
+ *    recorder.free();
+ * \endrst
+ */
+class NANOGUI_EXPORT GLFrameRecorder {
+public:
+    /// File formats supported by \ref start_sequence()
+    enum class Format {
+        TGA, ///< Uncompressed 32 bit TGA images
+        Raw  ///< Headerless 32 bit BGRA pixel data (bottom row first)
+    };
+
+    /**
+     * \brief Callback receiving mapped frames
+     *
+     * Arguments are the BGRA pixel data (bottom row first, no row padding),
+     * the frame size, and the index of the frame since \ref init().
+     */
+    using FrameCallback =
+        std::function<void(const uint8_t *, const Vector2i &, size_t)>;
+
+    /// Default constructor: unusable until you call the ``init()`` method
+    GLFrameRecorder() = default;
+
+    /// Stops the worker threads (OpenGL resources must be released using \ref free())
+    ~GLFrameRecorder();
+
+    /**
+     * \brief Allocate the read-back ring
+     *
+     * \param size
+     *     Size of the captured region in pixels (i.e. the framebuffer size)
+     *
+     * \param ring_size
+     *     Number of pixel buffer objects that may be in flight at once
+     *
+     * \param thread_count
+     *     Number of worker threads used to write image sequences
+     */
+    void init(const Vector2i &size, size_t ring_size = 3, size_t thread_count = 2);
+
+    /// Release all associated resources (requires the OpenGL context)
+    void free();
+
+    /**
+     * \brief Start writing an image sequence
+     *
+     * \param pattern
+     *     ``printf``-style filename pattern with one integer conversion, which
+     *     receives the frame index (e.g. ``"capture/frame_%05i.tga"``)
+     */
+    void start_sequence(const std::string &pattern, Format format = Format::TGA);
+
+    /// Start appending all subsequent frames to a single raw BGRA video stream
+    void start_stream(const std::string &filename);
+
+    /// Finish writing all outstanding frames, then stop the worker threads
+    void stop();
+
+    /// Is an image sequence or stream currently being written?
+    bool recording() const { return !m_workers.empty(); }
+
+    /// Set a callback that receives each mapped frame without copies
+    void set_frame_callback(const FrameCallback &callback) { m_frame_callback = callback; }
+
+    /// Return the callback that receives each mapped frame
+    const FrameCallback &frame_callback() const { return m_frame_callback; }
+
+    /// Maximum number of frames waiting for the worker threads before frames are dropped
+    size_t max_queued_frames() const { return m_max_queued_frames; }
+
+    /// Set the maximum number of frames waiting for the worker threads
+    void set_max_queued_frames(size_t value) { m_max_queued_frames = value; }
+
+    /**
+     * \brief Schedule an asynchronous read-back of the given framebuffer
+     *
+     * Also hands previously captured frames that have become available to
+     * the frame callback and worker threads.
+     */
+    void capture(GLuint framebuffer = 0);
+
+    /// Convenience overload capturing a \ref GLFramebuffer
+    void capture(const GLFramebuffer &framebuffer) { capture(framebuffer.framebuffer_id()); }
+
+    /// Block until all scheduled read-backs have been delivered and written
+    void flush();
+
+    /// Return the number of frames captured since \ref init()
+    size_t frame_count() const { return m_frame_count; }
+
+    /// Return the number of frames that were dropped because the writers fell behind
+    size_t frames_dropped() const { return m_frames_dropped; }
+
+protected:
+    /// A pixel buffer object of the read-back ring
+    struct Slot {
+        GLuint pbo = 0;
+        void *fence = nullptr; // GLsync (unavailable on GLES2)
+        size_t frame = 0;
+    };
+
+    /// A frame waiting to be written by the worker threads
+    struct Job {
+        size_t frame;
+        std::vector<uint8_t> data;
+    };
+
+    void retire(Slot &slot);
+    void submit(size_t frame, const uint8_t *data);
+    void write(const Job &job);
+    void start_workers(size_t count);
+    void stop_workers();
+
+protected:
+    Vector2i m_size = Vector2i(0, 0);
+    size_t m_frame_bytes = 0;
+    std::vector<Slot> m_slots;
+    size_t m_head = 0;
+    size_t m_frame_count = 0;
+    size_t m_thread_count = 2;
+    size_t m_max_queued_frames = 8;
+    FrameCallback m_frame_callback;
+
+    /* Output state (read by the worker threads) */
+    std::string m_pattern;
+    Format m_format = Format::TGA;
+    FILE *m_stream = nullptr;
+
+    /* Worker state (protected by m_mutex) */
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_jobs_cond, m_idle_cond;
+    std::deque<Job> m_jobs;
+    std::vector<std::vector<uint8_t>> m_buffer_pool;
+    size_t m_jobs_active = 0;
+    size_t m_frames_dropped = 0;
+    bool m_stop = false;
+};
+
+//  ----------------------------------------------------
+
 /**
  * \struct Arcball glutil.h nanogui/glutil.h
  *
@@ -0,0 +1,112 @@
+/*
+    nanogui/imageatlas.h -- Shelf-packed atlas of small RGBA images
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class ImageAtlas imageatlas.h nanogui/imageatlas.h
+ *
+ * \brief Packs many small RGBA images into a few large NanoVG textures.
+ *
+ * Drawing each small image from its own texture forces the renderer to
+ * switch textures between draw calls. The atlas instead places the images
+ * into shared square pages using a shelf packer: every page is divided into
+ * horizontal shelves, and each image goes to the lowest shelf that is tall
+ * enough (but not much taller) and has room left, or opens a new shelf. New
+ * pages are allocated when a page is full.
+ *
+ * A copy of every page is kept in memory, and only the rows modified since
+ * the last call to \ref upload() are transferred to the GPU.
+ */
+class NANOGUI_EXPORT ImageAtlas : public Object {
+public:
+    /// Location of an image within the atlas
+    struct Region {
+        /// NanoVG handle of the page containing the image (0: not in the atlas)
+        int image = 0;
+        /// Position and size of the image on the page in pixels
+        int x = 0, y = 0, width = 0, height = 0;
+    };
+
+    /**
+     * \brief Create an empty atlas
+     *
+     * \param ctx
+     *     NanoVG context owning the page textures
+     *
+     * \param page_size
+     *     Width and height of the pages in pixels
+     *
+     * \param padding
+     *     Number of transparent pixels between neighboring images, which
+     *     prevents texture filtering from bleeding across images
+     */
+    ImageAtlas(NVGcontext *ctx, int page_size = 2048, int padding = 1);
+
+    /**
+     * \brief Copy an RGBA image into the atlas
+     *
+     * Returns an empty region (with \c image equal to 0) if the image is
+     * larger than a page. The pixels only become visible after the next call
+     * to \ref upload().
+     */
+    Region add(int width, int height, const uint8_t *data);
+
+    /// Transfer the modified rows of all pages to the GPU
+    void upload();
+
+    /// Delete all pages
+    void clear();
+
+    /// Return the NanoVG context owning the pages
+    NVGcontext *nvg_context() const { return m_ctx; }
+
+    /// Return the width and height of the pages in pixels
+    int page_size() const { return m_page_size; }
+
+    /// Return the number of allocated pages
+    size_t page_count() const { return m_pages.size(); }
+
+    /// Return the texture memory of all pages in bytes
+    size_t memory_usage() const { return m_pages.size() * (size_t) m_page_size * m_page_size * 4; }
+
+protected:
+    virtual ~ImageAtlas();
+
+    struct Shelf {
+        int y, height, x;
+    };
+
+    struct Page {
+        int image;
+        std::vector<uint8_t> data;
+        std::vector<Shelf> shelves;
+        /// Range of rows modified since the last upload
+        int dirty_begin, dirty_end;
+    };
+
+    /// Reserve space for a (padded) rectangle on the given page
+    bool allocate(Page &page, int width, int height, int &x, int &y);
+
+protected:
+    NVGcontext *m_ctx;
+    int m_page_size;
+    int m_padding;
+    std::vector<Page> m_pages;
+};
+
+NAMESPACE_END(nanogui)
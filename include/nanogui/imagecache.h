@@ -0,0 +1,174 @@
+/*
+    nanogui/imagecache.h -- Per-context cache of NanoVG images with LRU
+    eviction
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <string>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class ImageCache imagecache.h nanogui/imagecache.h
+ *
+ * \brief Cache of NanoVG images owned by a NanoVG context.
+ *
+ * Images are identified by a key (the filename for images loaded from disk)
+ * and created at most once per context. The cache accounts for the texture
+ * memory of its images and evicts the least recently used ones once the
+ * memory exceeds its budget. Images used during the current or the previous
+ * frame and images marked as non-evictable are never evicted.
+ *
+ * Evicted images can be brought back: \ref touch() recreates them from their
+ * original source and returns the new handle. Widgets that draw cached
+ * images should call \ref touch() once per frame for every image they draw;
+ * this also marks the image as recently used.
+ *
+ * Every \ref Screen owns the cache of its context and releases it before
+ * deleting the context. Applications managing NanoVG contexts themselves
+ * should call \ref release() before deleting a context.
+ */
+class NANOGUI_EXPORT ImageCache : public Object {
+public:
+    /// Return the cache of the given NanoVG context (created on first use)
+    static ImageCache *get(NVGcontext *ctx);
+
+    /// Delete all images cached for the given NanoVG context and the cache itself
+    static void release(NVGcontext *ctx);
+
+    /**
+     * \brief Load an image file (or return the cached image)
+     *
+     * \param filename
+     *     Path of the image file (used as the key)
+     *
+     * \param flags
+     *     NanoVG image flags (see ``NVGimageFlags``)
+     *
+     * \param evictable
+     *     May the image be evicted when the cache exceeds its budget?
+     *
+     * \return The NanoVG image handle. Throws an exception on failure.
+     */
+    int load_file(const std::string &filename, int flags = 0, bool evictable = true);
+
+    /**
+     * \brief Decode an image from memory (or return the cached image)
+     *
+     * Unless \c evictable is \c false, the data must remain valid for the
+     * lifetime of the cache, since evicted images are decoded again.
+     */
+    int load_mem(const std::string &key, const uint8_t *data, size_t size,
+                 int flags = 0, bool evictable = false);
+
+    /**
+     * \brief Add an image created by other means (e.g. ``nvgCreateImageRGBA``)
+     *
+     * The cache takes ownership of the image. Such images cannot be
+     * recreated and are therefore never evicted.
+     */
+    int insert(const std::string &key, int image);
+
+    /// Return the handle of the image with the given key (or 0) and mark it as used
+    int find(const std::string &key);
+
+    /**
+     * \brief Mark an image as used in the current frame
+     *
+     * Returns the handle under which the image can be drawn: \c image itself,
+     * or a new handle if the image was evicted and had to be recreated.
+     * Handles not managed by the cache are returned unchanged. Only the most
+     * recent evictions (see \ref max_evicted) are remembered; older evicted
+     * handles are returned unchanged as well.
+     */
+    int touch(int image);
+
+    /// Delete the image with the given key (e.g. because the file changed)
+    void invalidate(const std::string &key);
+
+    /// Delete all images
+    void clear();
+
+    /// Advance the frame counter and evict images if needed (called by \ref Screen)
+    void next_frame();
+
+    /// Return the memory budget in bytes
+    size_t budget() const { return m_budget; }
+
+    /// Set the memory budget in bytes (evicts images if needed)
+    void set_budget(size_t budget);
+
+    /// Return the estimated texture memory of all cached images in bytes
+    size_t memory_usage() const;
+
+    /// Return the number of cached images
+    size_t size() const;
+
+    /// Return the number of images evicted so far
+    size_t evictions() const { return m_evictions; }
+
+    /// Number of evicted images whose source is remembered by \ref touch()
+    static constexpr size_t max_evicted = 4096;
+
+protected:
+    explicit ImageCache(NVGcontext *ctx) : m_ctx(ctx) { }
+    virtual ~ImageCache();
+
+    /// Where an image comes from (needed to recreate it after eviction)
+    struct Source {
+        std::string key;
+        std::string filename;
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+        int flags = 0;
+    };
+
+    struct Entry {
+        Source source;
+        int image;
+        size_t bytes;
+        uint64_t last_use;
+        bool evictable;
+    };
+
+    using List = std::list<Entry>;
+
+    /* The following functions require m_mutex */
+    int create(const Source &source);
+    int add(Source &&source, int image, bool evictable);
+    void use(List::iterator it);
+    void remove(List::iterator it, bool delete_image);
+    void trim();
+
+protected:
+    NVGcontext *m_ctx;
+    /// Resident images, most recently used first
+    List m_entries;
+    std::unordered_map<std::string, List::iterator> m_by_key;
+    std::unordered_map<int, List::iterator> m_by_image;
+    /// Sources of evicted images by their former handle
+    std::unordered_map<int, Source> m_evicted;
+    /// Former handles in the order of their eviction (at most \ref max_evicted)
+    std::deque<int> m_evicted_order;
+    size_t m_budget = 128 * 1024 * 1024;
+    size_t m_memory_usage = 0;
+    size_t m_evictions = 0;
+    uint64_t m_frame = 0;
+    mutable std::mutex m_mutex;
+};
+
+NAMESPACE_END(nanogui)
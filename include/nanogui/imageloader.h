@@ -0,0 +1,199 @@
+/*
+    nanogui/imageloader.h -- Asynchronous loader generating thumbnails of
+    a directory of images
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/imageatlas.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class ImageLoader imageloader.h nanogui/imageloader.h
+ *
+ * \brief Loads a directory of PNG images as thumbnails without blocking the
+ * user interface.
+ *
+ * Images are decoded and downsampled by tasks running on the shared
+ * \ref ThreadPool, one image per task. Images that have not been picked up
+ * yet can be cancelled (see \ref cancel()). The resulting
+ * thumbnails are uploaded incrementally by \ref update(), which must be
+ * called on the thread owning the OpenGL context (\ref ImagePanel does so
+ * while drawing when the loader is attached via \ref ImagePanel::set_loader()).
+ * The image handles listed by \ref images() are zero until the corresponding
+ * thumbnail has arrived.
+ *
+ * The loader must not outlive its screen. Its destructor waits for its
+ * running tasks, hence it must not be destroyed from within a pool task.
+ *
+ * Thumbnails are stored in the \ref ImageCache of the screen's context,
+ * hence loading the same directory again completes immediately. Loading
+ * another directory releases the thumbnails of images that it does not
+ * contain. Alternatively,
+ * they can be packed into an \ref ImageAtlas (see \ref set_atlas()). An optional
+ * on-disk cache (see \ref set_cache_directory()) additionally avoids
+ * decoding the original images in later sessions.
+ */
+class NANOGUI_EXPORT ImageLoader : public Object {
+public:
+    typedef std::vector<std::pair<int, std::string>> Images;
+
+    /**
+     * \brief Create a loader for the given screen
+     *
+     * \param screen
+     *     Screen whose NanoVG context receives the thumbnails. It is redrawn
+     *     whenever new thumbnails are ready for upload.
+     *
+     * \param thumbnail_size
+     *     Images are downsampled so that their smaller side has this many
+     *     pixels (images that are already smaller are left unchanged)
+     *
+     * \param thread_count
+     *     Maximum number of images decoded concurrently (0: one per worker
+     *     of the thread pool)
+     */
+    ImageLoader(Screen *screen, int thumbnail_size = 128, size_t thread_count = 0);
+
+    /**
+     * \brief Start loading all PNG images of a directory
+     *
+     * Cancels any images still pending from a previous call. Throws an
+     * exception if the directory cannot be opened.
+     */
+    void load_directory(const std::string &path);
+
+    /// Stop decoding images that have not been processed yet
+    void cancel();
+
+    /**
+     * \brief Upload decoded thumbnails (requires the OpenGL context)
+     *
+     * \param max_uploads
+     *     Maximum number of thumbnails uploaded per call, which bounds the
+     *     time spent per frame
+     *
+     * \return \c true if any image handle changed
+     */
+    bool update(size_t max_uploads = 32);
+
+    /// Return the images as (handle, name without extension) pairs; handles are 0 while loading
+    const Images &images() const { return m_images; }
+
+    /**
+     * \brief Pack thumbnails into an atlas instead of creating a texture per image
+     *
+     * The handle of an image packed into the atlas refers to the atlas page;
+     * \ref regions() specifies where on the page the thumbnail is. Thumbnails
+     * too large for the atlas still receive their own texture. The atlas is
+     * cleared whenever a new directory is loaded.
+     */
+    void set_atlas(ImageAtlas *atlas) { m_atlas = atlas; }
+
+    /// Return the atlas receiving the thumbnails (if any)
+    ImageAtlas *atlas() { return m_atlas; }
+
+    /// Return the atlas receiving the thumbnails (if any)
+    const ImageAtlas *atlas() const { return m_atlas.get(); }
+
+    /// Return the atlas region of each image (the region's image is 0 unless packed into the atlas)
+    const std::vector<ImageAtlas::Region> &regions() const { return m_regions; }
+
+    /// Return the number of images whose thumbnails have been uploaded
+    size_t loaded() const { return m_loaded; }
+
+    /// Return the number of images in the directory
+    size_t total() const { return m_images.size(); }
+
+    /// Return the fraction of images loaded so far
+    float progress() const { return m_images.empty() ? 1.f : m_loaded / (float) m_images.size(); }
+
+    /// Have all images been loaded?
+    bool finished() const { return m_loaded == m_images.size(); }
+
+    /// Set a callback that is invoked with the index and handle of each uploaded image
+    void set_callback(const std::function<void(size_t, int)> &callback) { m_callback = callback; }
+
+    /// Return the callback that is invoked for each uploaded image
+    const std::function<void(size_t, int)> &callback() const { return m_callback; }
+
+    /// Set a directory for storing thumbnails across sessions (empty: disabled)
+    void set_cache_directory(const std::string &path) { m_cache_directory = path; }
+
+    /// Return the directory storing thumbnails across sessions
+    const std::string &cache_directory() const { return m_cache_directory; }
+
+    /// Return the thumbnail size
+    int thumbnail_size() const { return m_thumbnail_size; }
+
+    /// Return the NanoVG context receiving the thumbnails
+    NVGcontext *nvg_context() const { return m_ctx; }
+
+protected:
+    virtual ~ImageLoader();
+
+    struct Job {
+        size_t index;
+        uint64_t generation;
+        std::string filename;
+    };
+
+    struct Result {
+        size_t index;
+        uint64_t generation;
+        std::string filename;
+        int width, height;
+        std::vector<uint8_t> data;
+    };
+
+    /// Queue decoding tasks on the thread pool as needed (requires m_mutex)
+    void schedule();
+    /// Decode the next image (runs on the thread pool)
+    void process();
+    bool decode(const Job &job, Result &result);
+    std::string cache_filename(const std::string &filename) const;
+
+protected:
+    Screen *m_screen;
+    NVGcontext *m_ctx;
+    int m_thumbnail_size;
+    std::string m_cache_directory;
+    Images m_images;
+    ref<ImageAtlas> m_atlas;
+    std::vector<ImageAtlas::Region> m_regions;
+    size_t m_loaded = 0;
+    std::function<void(size_t, int)> m_callback;
+    /// Cache keys of the thumbnails inserted into the \ref ImageCache
+    std::vector<std::string> m_keys;
+
+    /* Decoding state (protected by m_mutex) */
+    size_t m_max_tasks;
+    /// Number of tasks queued on the thread pool or running
+    size_t m_tasks = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<Job> m_jobs;
+    std::deque<Result> m_results;
+    /// Keys of thumbnails to be released by \ref update()
+    std::vector<std::string> m_stale_keys;
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+};
+
+NAMESPACE_END(nanogui)
@@ -16,6 +16,7 @@
 #if defined(NANOGUI_USE_GLWIDGETS)
 
 #include <nanogui/widget.h>
+#include <nanogui/imageloader.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -23,6 +24,9 @@ NAMESPACE_BEGIN(nanogui)
  * \class ImagePanel imagepanel.h nanogui/imagepanel.h
  *
  * \brief Image panel widget which shows a number of square-shaped icons.
+ *
+ * Only the rows within the visible area of the panel's ancestors (e.g. a
+ * \ref VScrollPanel) are drawn.
  */
 class NANOGUI_EXPORT ImagePanel : public Widget {
 public:
@@ -33,6 +37,18 @@ public:
     void set_images(const Images &data) { m_images = data; }
     const Images& images() const { return m_images; }
 
+    /**
+     * \brief Show the images of an \ref ImageLoader, which are uploaded
+     * while the panel is drawn
+     *
+     * Unless the loader already has an \ref ImageAtlas, the panel assigns
+     * one to it. This must happen before \ref ImageLoader::load_directory()
+     * for all thumbnails to be packed into the atlas.
+     */
+    void set_loader(ImageLoader *loader);
+    ImageLoader *loader() { return m_loader; }
+    const ImageLoader *loader() const { return m_loader.get(); }
+
     std::function<void(int)> callback() const { return m_callback; }
     void set_callback(const std::function<void(int)> &callback) { m_callback = callback; }
 
@@ -45,6 +61,7 @@ protected:
     int index_for_position(const Vector2i &p) const;
 protected:
     Images m_images;
+    ref<ImageLoader> m_loader;
     std::function<void(int)> m_callback;
     int m_thumb_size;
     int m_spacing;
@@ -0,0 +1,101 @@
+/*
+    nanogui/mpscqueue.h -- Lock-free queue with many producers and a
+    single consumer
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <atomic>
+#include <utility>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class MPSCQueue mpscqueue.h nanogui/mpscqueue.h
+ *
+ * \brief Unbounded FIFO queue that any number of threads may push to while
+ * a single thread pops from it.
+ *
+ * Pushing takes a single atomic exchange and never waits for other threads
+ * (the algorithm is due to Dmitry Vyukov). A pop that runs concurrently with
+ * an unfinished push may report an empty queue; the element becomes
+ * available once the push completes.
+ */
+template <typename T> class MPSCQueue {
+public:
+    MPSCQueue() : m_head(&m_stub), m_tail(&m_stub) { }
+
+    ~MPSCQueue() {
+        T value;
+        while (pop(value))
+            ;
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    /// Append an element (may be called from any thread)
+    void push(T value) {
+        Node *node = new Node();
+        node->value = std::move(value);
+        push_node(node);
+    }
+
+    /// Remove the oldest element (must only be called from the consumer thread)
+    bool pop(T &value) {
+        Node *tail = m_tail,
+             *next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &m_stub) {
+            if (!next)
+                return false;
+            m_tail = tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (!next) {
+            /* Either 'tail' is the last element, or a push is in progress */
+            if (tail != m_head.load(std::memory_order_acquire))
+                return false;
+            push_node(&m_stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (!next)
+                return false;
+        }
+
+        value = std::move(tail->value);
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+protected:
+    struct Node {
+        std::atomic<Node *> next { nullptr };
+        T value;
+    };
+
+    void push_node(Node *node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+protected:
+    /// Most recently pushed node (shared by the producers)
+    std::atomic<Node *> m_head;
+    /// Oldest node (owned by the consumer)
+    Node *m_tail;
+    Node m_stub;
+};
+
+NAMESPACE_END(nanogui)
@@ -29,6 +29,7 @@
 #include <nanogui/entypo.h>
 #include <nanogui/messagedialog.h>
 #include <nanogui/textbox.h>
+#include <nanogui/textarea.h>
 #include <nanogui/slider.h>
 #include <nanogui/imagepanel.h>
 #include <nanogui/imageview.h>
@@ -43,6 +43,23 @@ public:
      * the reference count reaches zero.
      */
     void dec_ref(bool dealloc = true) const noexcept;
+
+    /**
+     * \brief Allocate memory for an object (aligned to 16 bytes)
+     *
+     * The memory is taken from \ref Arena::current() if an \ref Arena::Scope
+     * is active on the current thread (and the object is small enough), and
+     * from the heap otherwise. Objects do not store their origin: \ref
+     * operator delete looks up the arena by address (see \ref Arena::owner()).
+     */
+    static void *operator new(size_t size);
+
+    /// Release the memory of an object to the arena or heap it came from
+    static void operator delete(void *ptr, size_t size) noexcept;
+
+    /// Construct an object in the given memory
+    static void *operator new(size_t, void *ptr) noexcept { return ptr; }
+    static void operator delete(void *, void *) noexcept { }
 protected:
     /** \brief Virtual protected deconstructor.
      * (Will only be called by \ref ref)
@@ -15,6 +15,12 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/mpscqueue.h>
+#include <nanogui/arena.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -110,6 +116,68 @@ public:
     /// Draw the Screen contents
     virtual void draw_all();
 
+    /**
+     * \brief Draw the screen on a dedicated render thread?
+     *
+     * By default, events, drawing and buffer swaps all take place on the
+     * thread running \ref mainloop(), hence a slow \ref draw_contents() or
+     * a swap waiting for the vertical blank delays the handling of input.
+     *
+     * When enabled, a render thread owning the screen's OpenGL context
+     * performs all drawing, while the main thread keeps handling events.
+     * The two threads only synchronize while the render thread builds the
+     * NanoVG commands of the widgets; \ref draw_contents(), the submission
+     * of the NanoVG commands and the buffer swap overlap with event
+     * handling.
+     *
+     * Events that arrive while the render thread draws the widgets are
+     * queued and handled afterwards, so that other screens remain responsive.
+     *
+     * While enabled, the OpenGL context is not current on the main thread,
+     * and \ref draw_contents() runs concurrently with event handlers: state
+     * shared between them must be synchronized by the application (e.g.
+     * by holding \ref ui_mutex()). Must be called from the main thread,
+     * outside of event handlers.
+     */
+    void set_threaded_rendering(bool value);
+
+    /// Does the screen draw on a dedicated render thread?
+    bool threaded_rendering() const { return m_render_thread.joinable(); }
+
+    /**
+     * \brief Return the mutex protecting the widget hierarchy
+     *
+     * It is held while events are dispatched and while the widgets are
+     * drawn. Code modifying widgets from other threads must hold it as well.
+     */
+    std::recursive_mutex &ui_mutex() { return m_ui_mutex; }
+
+    /**
+     * \brief Return the pool allocator for the widgets of this screen
+     *
+     * Widgets are only allocated from it within an \ref Arena::Scope, e.g.
+     * \code
+     * Arena::Scope scope(screen->arena());
+     * \endcode
+     */
+    Arena *arena() {
+        if (!m_arena)
+            m_arena = new Arena();
+        return m_arena;
+    }
+
+    /**
+     * \brief Run a function on the main thread before the next frame
+     *
+     * May be called from any thread (e.g. by a background task reporting
+     * its progress), and is the preferred way of modifying widgets from
+     * other threads. The functions run in the order in which they were
+     * posted, while holding \ref ui_mutex(), and the screen is redrawn
+     * afterwards. Posting does not block and wakes up \ref mainloop() if
+     * it is waiting for events.
+     */
+    void post(const std::function<void()> &func);
+
     /// Draw the window contents --- put your OpenGL draw calls here
     virtual void draw_contents() { /* To be overridden */ }
 
@@ -141,6 +209,81 @@ public:
     /// Return a pointer to the underlying NanoVG draw context
     NVGcontext *nvg_context() { return m_nvg_context; }
 
+    /**
+     * \brief Should screens created from now on share OpenGL objects?
+     *
+     * When enabled, the OpenGL context of each new screen joins the context
+     * group of the existing screens, so that textures, buffers, and shader
+     * programs created in one of them can be used by all of them. Each
+     * screen still loads its fonts and rasterizes glyphs into its own atlas,
+     * since the font stash of NanoVG is private to each NanoVG context.
+     * Disabled by default.
+     */
+    static void set_context_sharing(bool value);
+
+    /// Do screens created from now on share OpenGL objects?
+    static bool context_sharing();
+
+    /// Statistics about the glyph atlas that NanoVG maintains for this screen
+    struct GlyphAtlasStats {
+        /// Number of atlas textures (pages) currently allocated
+        size_t pages = 0;
+        /// Memory used by the atlas textures in bytes
+        size_t bytes = 0;
+        /// Estimated fraction of the current page that is occupied by glyphs
+        float occupancy = 0.f;
+        /// Number of times the atlas overflowed, evicting all cached glyphs
+        size_t evictions = 0;
+        /// Number of bytes uploaded to the atlas while drawing the last frame
+        size_t upload_bytes = 0;
+        /// Number of bytes uploaded to the atlas since the screen was created
+        size_t upload_bytes_total = 0;
+    };
+
+    /**
+     * \brief Return statistics about the glyph atlas of this screen
+     *
+     * NanoVG rasterizes glyphs into an atlas texture on demand and only
+     * uploads the modified region. When the atlas is full, a larger page is
+     * allocated (up to 2048x2048), and all glyphs are evicted and
+     * re-rasterized. These statistics reveal whether an application's text
+     * causes such evictions (and the associated hitches) in steady state.
+     *
+     * The statistics are updated while drawing (possibly on the render
+     * thread), hence a copy taken under \ref ui_mutex() is returned.
+     */
+    GlyphAtlasStats glyph_atlas_stats() const;
+
+    /**
+     * \brief Return the number of NanoVG render calls (fills, strokes, and
+     * text or triangle batches) issued while drawing the last frame
+     *
+     * The OpenGL backend turns each of them into at least one draw call.
+     */
+    size_t render_calls() const;
+
+    /**
+     * \brief Return the time (in seconds since \ref nanogui::init()) at which
+     * the first frame of this screen was presented, or -1 if no frame has
+     * been drawn yet
+     *
+     * Useful for tracking the startup latency of applications.
+     */
+    double first_frame_time() const { return m_first_frame_time; }
+
+    /**
+     * \brief Rasterize the glyphs of the built-in widgets while drawing the
+     * next frame (see \ref Theme::prewarm_glyphs())
+     *
+     * Not done by default, since it lengthens the frame in question. Useful
+     * e.g. right after the first frame was presented, so that text shown
+     * later on does not cause hitches.
+     *
+     * \param extra
+     *     Additional UTF-8 text rendered in the default text faces and sizes
+     */
+    void prewarm_glyphs(const std::string &extra = "");
+
     /// Shut down GLFW when the window is closed?
     void set_shutdown_glfw(bool v) { m_shutdown_glfw = v; }
     bool shutdown_glfw() { return m_shutdown_glfw; }
@@ -190,6 +333,12 @@ public:
     void center_window(Window *window);
     void move_window_to_front(Window *window);
     void draw_widgets();
+    void render_thread();
+
+    /// Handle an event now, or once the render thread releases the widgets
+    void dispatch_event(std::function<void()> &&event);
+    /// Handle the events queued by dispatch_event() and the functions passed to post() (main thread only)
+    void process_pending_events();
 
 protected:
     GLFWwindow *m_glfw_window;
@@ -209,8 +358,25 @@ protected:
     std::string m_caption;
     bool m_shutdown_glfw;
     bool m_fullscreen;
-    bool m_redraw;
+    std::atomic<bool> m_redraw;
     std::function<void(Vector2i)> m_resize_callback;
+    double m_first_frame_time = -1;
+    /// Pending \ref prewarm_glyphs() request (protected by m_ui_mutex)
+    bool m_prewarm_glyphs = false;
+    std::string m_prewarm_text;
+    /// Statistics of the last frame (protected by m_ui_mutex)
+    GlyphAtlasStats m_glyph_atlas_stats;
+    size_t m_render_calls = 0;
+    mutable std::recursive_mutex m_ui_mutex;
+    std::thread m_render_thread;
+    std::mutex m_render_mutex;
+    std::condition_variable m_render_cond;
+    bool m_render_stop = false;
+    std::mutex m_event_mutex;
+    std::vector<std::function<void()>> m_pending_events;
+    MPSCQueue<std::function<void()>> m_posted;
+    std::atomic<bool> m_posted_pending { false };
+    ref<Arena> m_arena;
 };
 
 NAMESPACE_END(nanogui)
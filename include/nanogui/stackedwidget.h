@@ -34,6 +34,7 @@ public:
     virtual void perform_layout(NVGcontext* ctx) override;
     virtual Vector2i preferred_size(NVGcontext* ctx) const override;
     virtual void add_child(int index, Widget* widget) override;
+    virtual void add_children(int index, Widget *const *widgets, size_t count) override;
 
 private:
     int m_selected_index = -1;
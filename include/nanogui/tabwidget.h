@@ -75,6 +75,9 @@ public:
      */
     virtual void add_child(int index, Widget *widget) override;
 
+    /// Forcibly prevent mis-use of the class by throwing an exception (see \ref add_child()).
+    virtual void add_children(int index, Widget *const *widgets, size_t count) override;
+
     void set_active_tab(int tab_index);
     int active_tab() const;
     int tab_count() const;
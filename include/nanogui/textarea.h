@@ -0,0 +1,158 @@
+/*
+    nanogui/textarea.h -- Multi-line text editor for large documents
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/widget.h>
+#include <map>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TextArea textarea.h nanogui/textarea.h
+ *
+ * \brief Multi-line text editor and viewer for large documents.
+ *
+ * The UTF-8 text is stored in a gap buffer: the unused space of the buffer
+ * is kept at the last edit position, hence typing only moves the bytes
+ * between consecutive edit positions. The start of every line is stored in
+ * a second gap buffer, where lines in front of the gap store their offset
+ * from the beginning of the text and lines behind it their offset from the
+ * end, so that edits do not have to update the lines that follow. Looking
+ * up the line containing a position is a binary search.
+ *
+ * Only the visible lines are drawn, and the caret positions of every
+ * visible line are measured once and cached until the line changes. Lines
+ * are not wrapped; long lines scroll horizontally.
+ */
+class NANOGUI_EXPORT TextArea : public Widget {
+public:
+    TextArea(Widget *parent);
+
+    /// Return a copy of the text
+    std::string value() const;
+
+    /// Replace the text (moves the cursor to the beginning)
+    void set_value(const std::string &value);
+
+    /// Insert text at the cursor, replacing the selection
+    void insert(const std::string &text);
+
+    /// Append text at the end (e.g. log output); keeps the view at the end if it was there
+    void append(const std::string &text);
+
+    /// Return the size of the text in bytes
+    size_t size() const { return m_text.size() - (m_gap_end - m_gap_begin); }
+
+    /// Return the number of lines
+    size_t line_count() const { return m_lines.size() - (m_lines_gap_end - m_lines_gap_begin); }
+
+    /// Return the given line without its line break
+    std::string line(size_t index) const;
+
+    /// Can the text be edited?
+    bool editable() const { return m_editable; }
+
+    /// Specify whether the text can be edited
+    void set_editable(bool editable);
+
+    /// Return the byte offset of the cursor
+    size_t cursor_pos() const { return m_cursor_pos; }
+
+    /// Move the cursor (and clear the selection)
+    void set_cursor_pos(size_t pos);
+
+    /// Return the selected text
+    std::string selection() const;
+
+    /// The callback to execute when the user has changed the text
+    const std::function<void()> &callback() const { return m_callback; }
+
+    /// Set the callback to execute when the user has changed the text
+    void set_callback(const std::function<void()> &callback) { m_callback = callback; }
+
+    virtual Vector2i preferred_size(NVGcontext *ctx) const override;
+    virtual void draw(NVGcontext *ctx) override;
+    virtual bool mouse_button_event(const Vector2i &p, int button, bool down, int modifiers) override;
+    virtual bool mouse_drag_event(const Vector2i &p, const Vector2i &rel, int button, int modifiers) override;
+    virtual bool scroll_event(const Vector2i &p, const Vector2f &rel) override;
+    virtual bool focus_event(bool focused) override;
+    virtual bool keyboard_event(int key, int scancode, int action, int modifiers) override;
+    virtual bool keyboard_character_event(unsigned int codepoint) override;
+
+protected:
+    /* Text storage */
+    char at(size_t pos) const {
+        return m_text[pos < m_gap_begin ? pos : pos + (m_gap_end - m_gap_begin)];
+    }
+    void copy(size_t begin, size_t end, std::string &out) const;
+    void move_gap(size_t pos);
+    void insert_text(size_t pos, const char *data, size_t size);
+    void erase_text(size_t begin, size_t end);
+    size_t next_char(size_t pos) const;
+    size_t prev_char(size_t pos) const;
+
+    /* Line index */
+    size_t line_start(size_t line) const;
+    /// Return the position of the line break ending the line (or the end of the text)
+    size_t line_end(size_t line) const;
+    /// Return the line containing the given position
+    size_t line_of(size_t pos) const;
+    /// Move the gap of the line index behind the given number of lines
+    void move_lines_gap(size_t count);
+
+    /* Caret positions (require the Screen's NanoVG context) */
+    const std::vector<float> &glyphs(NVGcontext *ctx, size_t line);
+    void invalidate_glyphs(size_t line, bool following);
+    size_t position_at(NVGcontext *ctx, size_t line, float x);
+    size_t position_at(const Vector2i &p);
+    float caret_x(NVGcontext *ctx, size_t pos);
+
+    /* Editing helpers */
+    void set_font(NVGcontext *ctx);
+    void move_cursor(size_t pos, bool select);
+    void move_vertically(long lines, bool select);
+    bool delete_selection();
+    void changed();
+    float line_height() const { return font_size() * 1.25f; }
+    int visible_lines() const;
+    double max_scroll() const;
+    float scrollbar_size() const;
+
+protected:
+    /// Text with a gap of unused bytes at [m_gap_begin, m_gap_end)
+    std::vector<char> m_text;
+    size_t m_gap_begin = 0, m_gap_end = 0;
+    /// Line starts with a gap at [m_lines_gap_begin, m_lines_gap_end) (see the class documentation)
+    std::vector<size_t> m_lines;
+    size_t m_lines_gap_begin = 0, m_lines_gap_end = 0;
+
+    /// Caret position in front of every byte of a line and at its end, by line
+    std::map<size_t, std::vector<float>> m_glyphs;
+    float m_glyphs_font_size = 0;
+
+    bool m_editable = true;
+    size_t m_cursor_pos = 0;
+    /// Other end of the selection (equal to m_cursor_pos if nothing is selected)
+    size_t m_selection_pos = 0;
+    /// Horizontal caret position kept while moving up and down (negative: none)
+    float m_preferred_x = -1;
+    /// Scroll offsets in pixels (double precision: documents may have millions of lines)
+    double m_scroll_y = 0;
+    float m_scroll_x = 0;
+    bool m_scroll_to_cursor = false;
+    bool m_scroll_to_end = false;
+    bool m_drag_scrollbar = false;
+    std::function<void()> m_callback;
+};
+
+NAMESPACE_END(nanogui)
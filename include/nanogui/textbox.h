@@ -65,8 +65,16 @@ public:
 
     /// Return the underlying regular expression specifying valid formats
     const std::string &format() const { return m_format; }
-    /// Specify a regular expression specifying valid formats
-    void set_format(const std::string &format) { m_format = format; }
+    /**
+     * \brief Specify a regular expression specifying valid formats
+     *
+     * The expression is compiled once here rather than whenever the value is
+     * validated. Compiled expressions are shared by all text boxes using the
+     * same format, and the formats of \ref IntBox and \ref FloatBox are
+     * validated by hand-written matchers. Throws an exception if the
+     * expression is invalid.
+     */
+    void set_format(const std::string &format);
 
     /// Return the placeholder text to be displayed while the text box is empty.
     const std::string &placeholder() const { return m_placeholder; }
@@ -98,12 +106,15 @@ protected:
     void paste_from_clipboard();
     bool delete_selection();
 
-    void update_cursor(NVGcontext *ctx, float lastx,
-                      const NVGglyphPosition *glyphs, int size);
-    float cursor_index2Position(int index, float lastx,
-                               const NVGglyphPosition *glyphs, int size);
-    int position2Cursor_index(float posx, float lastx,
-                             const NVGglyphPosition *glyphs, int size);
+    /* The following functions take the x coordinate where the text starts */
+    void update_cursor(float offset);
+    float cursor_index2Position(int index, float offset) const;
+    int position2Cursor_index(float posx, float offset) const;
+
+    /// Record that \c removed bytes at \c pos of m_value_temp were replaced by \c inserted bytes
+    void edit_glyphs(size_t pos, size_t removed, size_t inserted);
+    /// Measure the parts of m_value_temp that changed since the last call (needs the text font)
+    void update_glyphs(NVGcontext *ctx);
 
     /// The location (if any) for the spin area.
     enum class SpinArea { None, Top, Bottom };
@@ -118,10 +129,22 @@ protected:
     Alignment m_alignment;
     std::string m_units;
     std::string m_format;
+    /// Compiled version of m_format (empty if any value is valid)
+    std::function<bool(const std::string &)> m_format_validator;
     int m_units_image;
     std::function<bool(const std::string& str)> m_callback;
     bool m_valid_format;
     std::string m_value_temp;
+    /**
+     * Caret position in front of every byte of m_value_temp and after its
+     * last byte, relative to the start of the text. Edits only invalidate
+     * the positions in [m_glyph_dirty_first, m_glyph_dirty_last]; the
+     * positions after this range are off by a common shift.
+     */
+    std::vector<float> m_glyph_x;
+    size_t m_glyph_dirty_first = 1, m_glyph_dirty_last = 0;
+    float m_glyph_font_size = 0;
+    float m_line_height = 0;
     std::string m_placeholder;
     int m_cursor_pos;
     int m_selection_pos;
@@ -258,7 +281,7 @@ public:
     FloatBox(Widget *parent, Scalar value = (Scalar) 0.f) : TextBox(parent) {
         m_number_format = sizeof(Scalar) == sizeof(float) ? "%.4g" : "%.7g";
         set_default_value("0");
-        set_format("[-+]?[0-9]*\\.?[0-9]+([e_e][-+]?[0-9]+)?");
+        set_format("[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?");
         set_value_increment((Scalar) 0.1);
         set_min_max_values(std::numeric_limits<Scalar>::lowest(), std::numeric_limits<Scalar>::max());
         set_value(value);
@@ -31,6 +31,26 @@ class NANOGUI_EXPORT Theme : public Object {
 public:
     Theme(NVGcontext *ctx);
 
+    /**
+     * \brief Rasterize the glyphs used by the default widgets ahead of time
+     *
+     * Renders (invisibly) printable ASCII text and the theme's icons in the
+     * faces and sizes used by the built-in widgets, so that NanoVG does not
+     * need to rasterize them on demand while drawing later frames. This
+     * lengthens the frame in which it is called; it is only done on request
+     * (see \ref Screen::prewarm_glyphs()).
+     *
+     * Must be called between ``nvgBeginFrame()`` and ``nvgEndFrame()``.
+     *
+     * \param ctx
+     *     The NanoVG context whose glyph atlas should be populated
+     *
+     * \param extra
+     *     Additional UTF-8 text (e.g. non-ASCII characters used by the
+     *     application) rendered in the default text faces and sizes
+     */
+    void prewarm_glyphs(NVGcontext *ctx, const std::string &extra = "") const;
+
     /* Fonts */
     /// The standard font face (default: ``"sans"`` from ``resources/roboto_regular.ttf``).
     int m_font_normal;
@@ -52,6 +72,12 @@ public:
     int m_button_font_size;
     /// The font size for text boxes (default: ``20``).
     int m_text_box_font_size;
+    /// The font size for tooltips (default: ``15``).
+    int m_tooltip_font_size;
+    /// The font size for Window titles (default: ``18``).
+    int m_window_title_font_size;
+    /// Blur radius of the shadow behind Window titles (default: ``2``).
+    float m_window_title_shadow_blur;
     /// Rounding radius for Window widget corners (default: ``2``).
     int m_window_corner_radius;
     /// Default size of Window widget titles (default: ``30``).
@@ -0,0 +1,141 @@
+/*
+    nanogui/threadpool.h -- Work-stealing thread pool for background tasks
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <deque>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <type_traits>
+#include <iostream>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class ThreadPool threadpool.h nanogui/threadpool.h
+ *
+ * \brief Pool of worker threads executing background tasks.
+ *
+ * Every worker owns a queue of tasks. Tasks submitted by a worker (e.g. by
+ * a task splitting its work) go to the worker's own queue, which it
+ * processes in last-in first-out order, while tasks submitted by other
+ * threads are distributed over the queues in turn. Idle workers steal the
+ * oldest tasks from the queues of the other workers.
+ *
+ * The pool shared by the application is returned by \ref get() and shut
+ * down by \ref nanogui::shutdown(). Results can be consumed either through
+ * the \c std::future returned by \ref submit(), or by a continuation that
+ * runs on the main thread (see \ref submit_then()).
+ */
+class NANOGUI_EXPORT ThreadPool : public Object {
+public:
+    using Task = std::function<void()>;
+
+    /// Create a pool with the given number of workers (0: one per hardware thread)
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /// Return the pool shared by the application (created on first use)
+    static ThreadPool *get();
+
+    /// Shut down the shared pool after finishing its tasks (called by \ref nanogui::shutdown())
+    static void release();
+
+    /// Queue a task without tracking its completion
+    void enqueue(Task &&task);
+
+    /// Queue a function and return a future holding its result
+    template <typename Func>
+    auto submit(Func &&func) -> std::future<std::invoke_result_t<std::decay_t<Func>>> {
+        using Result = std::invoke_result_t<std::decay_t<Func>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> future = task->get_future();
+        enqueue([task] { (*task)(); });
+        return future;
+    }
+
+    /**
+     * \brief Queue a function and pass its result to a continuation that
+     * runs on the main thread
+     *
+     * The continuation is scheduled via \ref nanogui::async_ui(), hence it
+     * may freely modify widgets. It receives the result of \c func (or no
+     * argument if \c func returns \c void). If \c func throws an exception,
+     * the exception is reported and the continuation does not run.
+     */
+    template <typename Func, typename Then>
+    void submit_then(Func &&func, Then &&then) {
+        using Result = std::invoke_result_t<std::decay_t<Func>>;
+        enqueue([func = std::forward<Func>(func), then = std::forward<Then>(then)]() mutable {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    func();
+                    async_ui(std::move(then));
+                } else {
+                    auto result = std::make_shared<Result>(func());
+                    async_ui([then = std::move(then), result]() mutable { then(std::move(*result)); });
+                }
+            } catch (const std::exception &e) {
+                std::cerr << "Caught exception in background task: " << e.what() << std::endl;
+            }
+        });
+    }
+
+    /**
+     * \brief Process the range <tt>[begin, end)</tt> in parallel
+     *
+     * The range is divided into blocks of (at most) \c block_size indices,
+     * and \c func is invoked once per block with its first and one-past-last
+     * index. The calling thread processes blocks as well and returns once
+     * all blocks are done, hence \ref parallel_for() may also be called from
+     * within tasks. The first exception thrown by \c func is rethrown.
+     *
+     * \param block_size
+     *     Number of indices per block (0: a few blocks per worker)
+     */
+    void parallel_for(size_t begin, size_t end,
+                      const std::function<void(size_t, size_t)> &func,
+                      size_t block_size = 0);
+
+    /// Return the number of worker threads
+    size_t thread_count() const { return m_workers.size(); }
+
+    /// Return the number of tasks that have been queued but not started
+    size_t pending() const { return m_pending; }
+
+protected:
+    virtual ~ThreadPool();
+
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t index);
+    bool pop(size_t index, Task &task);
+    bool steal(size_t index, Task &task);
+
+protected:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_next { 0 };
+    std::atomic<size_t> m_pending { 0 };
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stop = false;
+};
+
+NAMESPACE_END(nanogui)
@@ -28,51 +28,383 @@ NAMESPACE_BEGIN(nanogui)
 NAMESPACE_END(nanogui)
 
 #else
-    #include <array>
+    #include <cmath>
+    #include <cstddef>
+    #include <type_traits>
+
+    /* 4-lane single precision arithmetic maps to SSE or NEON instructions.
+       Constant evaluation falls back to the scalar code, which requires
+       __builtin_is_constant_evaluated() */
+    #if defined(__clang__) && defined(__has_builtin)
+        #if __has_builtin(__builtin_is_constant_evaluated)
+            #define NANOGUI_VEC_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+        #endif
+    #elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+        #define NANOGUI_VEC_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+    #endif
+
+    #if defined(NANOGUI_VEC_CONSTANT_EVALUATED) && \
+        (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+        #include <xmmintrin.h>
+        #define NANOGUI_VEC_SSE 1
+    #elif defined(NANOGUI_VEC_CONSTANT_EVALUATED) && defined(__ARM_NEON) && defined(__aarch64__)
+        #include <arm_neon.h>
+        #define NANOGUI_VEC_NEON 1
+    #endif
 
 NAMESPACE_BEGIN(nanogui)
 
-    template<typename T>
-    class Vector2 {
-    private:
-        std::array<T, 2> m_values;
+NAMESPACE_BEGIN(detail)
 
-    public:
-        Vector2() {
-            m_values = {0,0};
-        }
-        Vector2(T x, T y) {
-            m_values = {x,y};
-        }
+#if defined(NANOGUI_VEC_SSE)
+    using Packet4f = __m128;
+    inline Packet4f load4f(const float *p) { return _mm_load_ps(p); }
+    inline void store4f(float *p, Packet4f v) { _mm_store_ps(p, v); }
+    inline Packet4f add4f(Packet4f a, Packet4f b) { return _mm_add_ps(a, b); }
+    inline Packet4f sub4f(Packet4f a, Packet4f b) { return _mm_sub_ps(a, b); }
+    inline Packet4f mul4f(Packet4f a, Packet4f b) { return _mm_mul_ps(a, b); }
+    inline Packet4f div4f(Packet4f a, Packet4f b) { return _mm_div_ps(a, b); }
+    inline Packet4f min4f(Packet4f a, Packet4f b) { return _mm_min_ps(a, b); }
+    inline Packet4f max4f(Packet4f a, Packet4f b) { return _mm_max_ps(a, b); }
+    inline float hsum4f(Packet4f a) {
+        Packet4f b = _mm_add_ps(a, _mm_movehl_ps(a, a));
+        return _mm_cvtss_f32(_mm_add_ss(b, _mm_shuffle_ps(b, b, 1)));
+    }
+#elif defined(NANOGUI_VEC_NEON)
+    using Packet4f = float32x4_t;
+    inline Packet4f load4f(const float *p) { return vld1q_f32(p); }
+    inline void store4f(float *p, Packet4f v) { vst1q_f32(p, v); }
+    inline Packet4f add4f(Packet4f a, Packet4f b) { return vaddq_f32(a, b); }
+    inline Packet4f sub4f(Packet4f a, Packet4f b) { return vsubq_f32(a, b); }
+    inline Packet4f mul4f(Packet4f a, Packet4f b) { return vmulq_f32(a, b); }
+    inline Packet4f div4f(Packet4f a, Packet4f b) { return vdivq_f32(a, b); }
+    inline Packet4f min4f(Packet4f a, Packet4f b) { return vminq_f32(a, b); }
+    inline Packet4f max4f(Packet4f a, Packet4f b) { return vmaxq_f32(a, b); }
+    inline float hsum4f(Packet4f a) { return vaddvq_f32(a); }
+#endif
 
-        T const & x() const {
-            return m_values[0];
-        }
-        T & x() {
-            return m_values[0];
-        }
-        T const & y() const {
-            return m_values[1];
-        }
-        T & y() {
-            return m_values[1];
-        }
-        T const & operator[](int i) const {
-            return m_values[i];
-        }
-        T & operator[](int i) {
-            return m_values[i];
-        }
-        Vector2<T> operator+(Vector2<T> const & other) const {
-            return Vector2<T>(x()+other.x(), y()+other.y());
-        }
-        Vector2<T> operator-(Vector2<T> const & other) const {
-            return Vector2<T>(x()-other.x(), y()-other.y());
+    /// Use SIMD instructions for arrays of this type?
+    template <typename Value, size_t Size> constexpr bool use_simd =
+#if defined(NANOGUI_VEC_SSE) || defined(NANOGUI_VEC_NEON)
+        std::is_same_v<Value, float> && Size == 4;
+#else
+        false;
+#endif
+
+NAMESPACE_END(detail)
+
+/**
+ * \class Array vec_types.h nanogui/vec_types.h
+ *
+ * \brief Small fixed-size vector with Enoki-compatible arithmetic.
+ *
+ * Used in place of \c enoki::Array when NanoGUI is compiled without Enoki.
+ * All operations are \c constexpr and work component-wise. Comparisons other
+ * than \c == and \c != produce masks (arrays of \c bool) that can be reduced
+ * using \ref all(), \ref any() and \ref none().
+ *
+ * Arrays of four floats are 16-byte aligned, and their arithmetic uses SSE
+ * or NEON instructions when available.
+ */
+template <typename Value_, size_t Size_> struct Array {
+    using Value = Value_;
+    static constexpr size_t Size = Size_;
+
+    /// Create a zero-initialized array
+    constexpr Array() : m_data{} { }
+
+    /// Broadcast a scalar to all components
+    constexpr Array(Value v) : m_data{} {
+        for (size_t i = 0; i < Size; ++i)
+            m_data[i] = v;
+    }
+
+    /// Initialize the components individually
+    template <typename... Ts, std::enable_if_t<sizeof...(Ts) == Size && (Size > 1), int> = 0>
+    constexpr Array(Ts... ts) : m_data{ Value(ts)... } { }
+
+    /// Convert the components of an array with a different type
+    template <typename Value2>
+    constexpr explicit Array(const Array<Value2, Size> &a) : m_data{} {
+        for (size_t i = 0; i < Size; ++i)
+            m_data[i] = Value(a[i]);
+    }
+
+    static constexpr size_t size() { return Size; }
+
+    constexpr Value *data() { return m_data; }
+    constexpr const Value *data() const { return m_data; }
+
+    constexpr Value &operator[](size_t i) { return m_data[i]; }
+    constexpr const Value &operator[](size_t i) const { return m_data[i]; }
+
+    constexpr Value &x() { return m_data[0]; }
+    constexpr const Value &x() const { return m_data[0]; }
+    constexpr Value &y() { static_assert(Size > 1, "Array::y(): out of range!"); return m_data[1]; }
+    constexpr const Value &y() const { static_assert(Size > 1, "Array::y(): out of range!"); return m_data[1]; }
+    constexpr Value &z() { static_assert(Size > 2, "Array::z(): out of range!"); return m_data[2]; }
+    constexpr const Value &z() const { static_assert(Size > 2, "Array::z(): out of range!"); return m_data[2]; }
+    constexpr Value &w() { static_assert(Size > 3, "Array::w(): out of range!"); return m_data[3]; }
+    constexpr const Value &w() const { static_assert(Size > 3, "Array::w(): out of range!"); return m_data[3]; }
+
+    /// Apply a binary function to all pairs of components
+    template <typename Func>
+    static constexpr auto map(const Array &a, const Array &b, Func func) {
+        Array<decltype(func(a[0], b[0])), Size> result;
+        for (size_t i = 0; i < Size; ++i)
+            result[i] = func(a[i], b[i]);
+        return result;
+    }
+
+#if defined(NANOGUI_VEC_SSE) || defined(NANOGUI_VEC_NEON)
+    /// Apply a binary SIMD operation (only for 4-lane float arrays)
+    template <typename Func>
+    static Array map_simd(const Array &a, const Array &b, Func func) {
+        Array result;
+        detail::store4f(result.m_data, func(detail::load4f(a.m_data),
+                                            detail::load4f(b.m_data)));
+        return result;
+    }
+    #define NANOGUI_VEC_SIMD_OP(a, b, op)                                     \
+        if constexpr (detail::use_simd<Value, Size>) {                        \
+            if (!NANOGUI_VEC_CONSTANT_EVALUATED())                            \
+                return map_simd(a, b, detail::op);                            \
         }
-    };
+#else
+    #define NANOGUI_VEC_SIMD_OP(a, b, op)
+#endif
+
+    friend constexpr Array operator+(const Array &a, const Array &b) {
+        NANOGUI_VEC_SIMD_OP(a, b, add4f)
+        return map(a, b, [](Value x, Value y) { return Value(x + y); });
+    }
+
+    friend constexpr Array operator-(const Array &a, const Array &b) {
+        NANOGUI_VEC_SIMD_OP(a, b, sub4f)
+        return map(a, b, [](Value x, Value y) { return Value(x - y); });
+    }
+
+    friend constexpr Array operator*(const Array &a, const Array &b) {
+        NANOGUI_VEC_SIMD_OP(a, b, mul4f)
+        return map(a, b, [](Value x, Value y) { return Value(x * y); });
+    }
+
+    friend constexpr Array operator/(const Array &a, const Array &b) {
+        NANOGUI_VEC_SIMD_OP(a, b, div4f)
+        return map(a, b, [](Value x, Value y) { return Value(x / y); });
+    }
+
+    friend constexpr Array min(const Array &a, const Array &b) {
+        NANOGUI_VEC_SIMD_OP(a, b, min4f)
+        return map(a, b, [](Value x, Value y) { return y < x ? y : x; });
+    }
+
+    friend constexpr Array max(const Array &a, const Array &b) {
+        NANOGUI_VEC_SIMD_OP(a, b, max4f)
+        return map(a, b, [](Value x, Value y) { return x < y ? y : x; });
+    }
+
+    #undef NANOGUI_VEC_SIMD_OP
+
+    friend constexpr Array operator-(const Array &a) { return Array(Value(0)) - a; }
+
+    constexpr Array &operator+=(const Array &a) { return *this = *this + a; }
+    constexpr Array &operator-=(const Array &a) { return *this = *this - a; }
+    constexpr Array &operator*=(const Array &a) { return *this = *this * a; }
+    constexpr Array &operator/=(const Array &a) { return *this = *this / a; }
+
+    friend constexpr Array<bool, Size> operator<(const Array &a, const Array &b) {
+        return map(a, b, [](Value x, Value y) { return x < y; });
+    }
+
+    friend constexpr Array<bool, Size> operator<=(const Array &a, const Array &b) {
+        return map(a, b, [](Value x, Value y) { return x <= y; });
+    }
+
+    friend constexpr Array<bool, Size> operator>(const Array &a, const Array &b) {
+        return map(a, b, [](Value x, Value y) { return x > y; });
+    }
+
+    friend constexpr Array<bool, Size> operator>=(const Array &a, const Array &b) {
+        return map(a, b, [](Value x, Value y) { return x >= y; });
+    }
+
+    /// Component-wise equality mask (\c == compares the whole array)
+    friend constexpr Array<bool, Size> eq(const Array &a, const Array &b) {
+        return map(a, b, [](Value x, Value y) { return x == y; });
+    }
+
+    /// Component-wise inequality mask (\c != compares the whole array)
+    friend constexpr Array<bool, Size> neq(const Array &a, const Array &b) {
+        return map(a, b, [](Value x, Value y) { return x != y; });
+    }
+
+    friend constexpr bool operator==(const Array &a, const Array &b) {
+        for (size_t i = 0; i < Size; ++i)
+            if (!(a[i] == b[i]))
+                return false;
+        return true;
+    }
+
+    friend constexpr bool operator!=(const Array &a, const Array &b) { return !(a == b); }
+
+private:
+    alignas(detail::use_simd<Value, Size> ? 16 : alignof(Value)) Value m_data[Size];
+};
+
+/* Masks */
+
+template <size_t Size> constexpr Array<bool, Size> operator&&(const Array<bool, Size> &a,
+                                                              const Array<bool, Size> &b) {
+    return Array<bool, Size>::map(a, b, [](bool x, bool y) { return x && y; });
+}
+
+template <size_t Size> constexpr Array<bool, Size> operator||(const Array<bool, Size> &a,
+                                                              const Array<bool, Size> &b) {
+    return Array<bool, Size>::map(a, b, [](bool x, bool y) { return x || y; });
+}
+
+template <size_t Size> constexpr Array<bool, Size> operator!(const Array<bool, Size> &a) {
+    Array<bool, Size> result;
+    for (size_t i = 0; i < Size; ++i)
+        result[i] = !a[i];
+    return result;
+}
+
+/// Are all components of the mask set?
+template <size_t Size> constexpr bool all(const Array<bool, Size> &a) {
+    for (size_t i = 0; i < Size; ++i)
+        if (!a[i])
+            return false;
+    return true;
+}
+
+/// Is any component of the mask set?
+template <size_t Size> constexpr bool any(const Array<bool, Size> &a) {
+    for (size_t i = 0; i < Size; ++i)
+        if (a[i])
+            return true;
+    return false;
+}
+
+/// Is no component of the mask set?
+template <size_t Size> constexpr bool none(const Array<bool, Size> &a) { return !any(a); }
+
+/// Pick components from \c a where the mask is set and from \c b elsewhere
+template <typename Value, size_t Size>
+constexpr Array<Value, Size> select(const Array<bool, Size> &mask, const Array<Value, Size> &a,
+                                    const Array<Value, Size> &b) {
+    Array<Value, Size> result;
+    for (size_t i = 0; i < Size; ++i)
+        result[i] = mask[i] ? a[i] : b[i];
+    return result;
+}
+
+/* Horizontal reductions */
+
+template <typename Value, size_t Size> constexpr Value hsum(const Array<Value, Size> &a) {
+#if defined(NANOGUI_VEC_SSE) || defined(NANOGUI_VEC_NEON)
+    if constexpr (detail::use_simd<Value, Size>) {
+        if (!NANOGUI_VEC_CONSTANT_EVALUATED())
+            return detail::hsum4f(detail::load4f(a.data()));
+    }
+#endif
+    Value result = a[0];
+    for (size_t i = 1; i < Size; ++i)
+        result += a[i];
+    return result;
+}
+
+template <typename Value, size_t Size> constexpr Value hprod(const Array<Value, Size> &a) {
+    Value result = a[0];
+    for (size_t i = 1; i < Size; ++i)
+        result *= a[i];
+    return result;
+}
+
+template <typename Value, size_t Size> constexpr Value hmin(const Array<Value, Size> &a) {
+    Value result = a[0];
+    for (size_t i = 1; i < Size; ++i)
+        result = a[i] < result ? a[i] : result;
+    return result;
+}
+
+template <typename Value, size_t Size> constexpr Value hmax(const Array<Value, Size> &a) {
+    Value result = a[0];
+    for (size_t i = 1; i < Size; ++i)
+        result = result < a[i] ? a[i] : result;
+    return result;
+}
+
+/* Component-wise functions */
+
+template <typename Value, size_t Size> constexpr Array<Value, Size> abs(const Array<Value, Size> &a) {
+    return select(a < Array<Value, Size>(Value(0)), -a, a);
+}
+
+template <typename Value, size_t Size>
+constexpr Array<Value, Size> clamp(const Array<Value, Size> &a, const Array<Value, Size> &lo,
+                                   const Array<Value, Size> &hi) {
+    return max(min(a, hi), lo);
+}
+
+template <typename Value, size_t Size> Array<Value, Size> floor(const Array<Value, Size> &a) {
+    Array<Value, Size> result;
+    for (size_t i = 0; i < Size; ++i)
+        result[i] = std::floor(a[i]);
+    return result;
+}
+
+template <typename Value, size_t Size> Array<Value, Size> ceil(const Array<Value, Size> &a) {
+    Array<Value, Size> result;
+    for (size_t i = 0; i < Size; ++i)
+        result[i] = std::ceil(a[i]);
+    return result;
+}
+
+template <typename Value, size_t Size> Array<Value, Size> round(const Array<Value, Size> &a) {
+    Array<Value, Size> result;
+    for (size_t i = 0; i < Size; ++i)
+        result[i] = std::round(a[i]);
+    return result;
+}
+
+/* Geometry */
+
+template <typename Value, size_t Size>
+constexpr Value dot(const Array<Value, Size> &a, const Array<Value, Size> &b) {
+    return hsum(a * b);
+}
+
+template <typename Value, size_t Size> constexpr Value squared_norm(const Array<Value, Size> &a) {
+    return dot(a, a);
+}
+
+template <typename Value, size_t Size> Value norm(const Array<Value, Size> &a) {
+    return std::sqrt(squared_norm(a));
+}
+
+template <typename Value, size_t Size> Array<Value, Size> normalize(const Array<Value, Size> &a) {
+    return a * Array<Value, Size>(Value(1) / norm(a));
+}
+
+template <typename Value>
+constexpr Array<Value, 3> cross(const Array<Value, 3> &a, const Array<Value, 3> &b) {
+    return Array<Value, 3>(a.y() * b.z() - a.z() * b.y(),
+                           a.z() * b.x() - a.x() * b.z(),
+                           a.x() * b.y() - a.y() * b.x());
+}
+
+template <typename T> using Vector2 = Array<T, 2>;
+template <typename T> using Vector3 = Array<T, 3>;
+template <typename T> using Vector4 = Array<T, 4>;
 
-    using Vector2f = Vector2<float>;
-    using Vector2i = Vector2<int32_t>;
+using Vector2f = Array<float, 2>;
+using Vector3f = Array<float, 3>;
+using Vector4f = Array<float, 4>;
+using Vector2i = Array<int32_t, 2>;
+using Vector3i = Array<int32_t, 3>;
+using Vector4i = Array<int32_t, 4>;
 
 NAMESPACE_END(nanogui)
 
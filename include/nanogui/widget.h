@@ -41,7 +41,29 @@ public:
     /// Return the parent widget
     const Widget *parent() const { return m_parent; }
     /// Set the parent widget
-    void set_parent(Widget *parent) { m_parent = parent; }
+    void set_parent(Widget *parent) {
+        if (m_parent != parent) {
+            m_parent = parent;
+            invalidate_cache();
+            update_owners();
+        }
+    }
+
+    /// Flags identifying the widget classes that are looked up without RTTI (see \ref kind())
+    enum Kind {
+        WindowKind = (1 << 0), ///< A Window (or subclass).
+        PopupKind  = (1 << 1), ///< A Popup (or subclass).
+        ScreenKind = (1 << 2)  ///< A Screen (or subclass).
+    };
+
+    /// Return the \ref Kind flags set by the constructors of this widget
+    int kind() const { return m_kind; }
+    /// Is this widget a \ref Window?
+    bool is_window() const { return m_kind & WindowKind; }
+    /// Is this widget a \ref Popup?
+    bool is_popup() const { return m_kind & PopupKind; }
+    /// Is this widget a \ref Screen?
+    bool is_screen() const { return m_kind & ScreenKind; }
 
     /// Return the used \ref Layout generator
     Layout *layout() { return m_layout; }
@@ -60,12 +82,24 @@ public:
     /// Return the position relative to the parent widget
     const Vector2i &position() const { return m_pos; }
     /// Set the position relative to the parent widget
-    void set_position(const Vector2i &pos) { m_pos = pos; }
+    void set_position(const Vector2i &pos) {
+        if (m_pos != pos) {
+            m_pos = pos;
+            invalidate_cache();
+        }
+    }
 
-    /// Return the absolute position on screen
+    /**
+     * \brief Return the absolute position on screen
+     *
+     * The absolute position and the visibility including the parents (see
+     * \ref visible_recursive()) are cached by every widget and recomputed
+     * once after the widget or one of its parents was moved, shown, hidden
+     * or reparented, hence repeated queries take constant time.
+     */
     Vector2i absolute_position() const {
-        return m_parent ?
-            (parent()->absolute_position() + m_pos) : m_pos;
+        update_cache();
+        return m_absolute_pos;
     }
 
     /// Return the size of the widget
@@ -109,17 +143,17 @@ public:
     /// Return whether or not the widget is currently visible (assuming all parents are visible)
     bool visible() const { return m_visible; }
     /// Set whether or not the widget is currently visible (assuming all parents are visible)
-    void set_visible(bool visible) { m_visible = visible; }
+    void set_visible(bool visible) {
+        if (m_visible != visible) {
+            m_visible = visible;
+            invalidate_cache();
+        }
+    }
 
     /// Check if this widget is currently visible, taking parent widgets into account
     bool visible_recursive() const {
-        bool visible = true;
-        const Widget *widget = this;
-        while (widget) {
-            visible &= widget->visible();
-            widget = widget->parent();
-        }
-        return visible;
+        update_cache();
+        return m_visible_recursive;
     }
 
     /// Return the number of child widgets
@@ -141,6 +175,16 @@ public:
     /// Convenience function which appends a widget at the end
     void add_child(Widget *widget);
 
+    /**
+     * \brief Add several existing child widgets at the specified index
+     *
+     * The widgets are inserted with a single reallocation of the list of
+     * children, and the theme is propagated to each of their subtrees once.
+     * Subclasses overriding \ref add_child() must override this function as
+     * well, since the default implementation does not call \ref add_child().
+     */
+    virtual void add_children(int index, Widget *const *widgets, size_t count);
+
     /// Remove a child widget by index
     void remove_child(int index);
 
@@ -162,10 +206,74 @@ public:
         return new WidgetClass(this, args...);
     }
 
-    /// Walk up the hierarchy and return the parent window
+    /**
+     * \class BatchBuilder widget.h nanogui/widget.h
+     *
+     * \brief Scope for adding many children to a widget.
+     *
+     * The builder reserves space for the expected number of children up
+     * front. Widgets constructed by \ref add() or passed to \ref add_child()
+     * are collected and inserted in order with a single call to
+     * \ref Widget::add_children() when the builder is flushed or goes out of
+     * scope.
+     *
+     * \ref add() constructs widgets without a parent and assigns the theme
+     * of the parent right away. Widgets whose constructors need their parent
+     * (e.g. \ref PopupButton, which attaches its popup to the window) must be
+     * constructed directly instead.
+     *
+     * \rst
+     * .. code-block:: cpp
+     *
+     *    Widget::BatchBuilder builder(panel, items.size());
+     *    for (const auto &item : items)
+     *        builder.add<Label>(item);
+     *
+     * \endrst
+     */
+    class NANOGUI_EXPORT BatchBuilder {
+    public:
+        /// Start adding children to \c parent, reserving space for \c expected more
+        BatchBuilder(Widget *parent, size_t expected = 0);
+
+        /// Insert the collected widgets
+        ~BatchBuilder() { flush(); }
+
+        BatchBuilder(const BatchBuilder &) = delete;
+        BatchBuilder &operator=(const BatchBuilder &) = delete;
+
+        /// Construct a new child widget (inserted by the next \ref flush())
+        template <typename WidgetClass, typename... Args>
+        WidgetClass *add(const Args&... args) {
+            WidgetClass *widget = new WidgetClass(nullptr, args...);
+            widget->set_theme(m_parent->theme());
+            m_pending.push_back(widget);
+            return widget;
+        }
+
+        /// Append an existing widget (inserted by the next \ref flush())
+        void add_child(Widget *widget) { m_pending.push_back(widget); }
+
+        /// Append a range of existing widgets (inserted by the next \ref flush())
+        template <typename Iterator> void add_children(Iterator begin, Iterator end) {
+            m_pending.insert(m_pending.end(), begin, end);
+        }
+
+        /// Insert the widgets collected so far
+        void flush();
+
+        /// Return the widget receiving the children
+        Widget *parent() { return m_parent; }
+
+    protected:
+        Widget *m_parent;
+        std::vector<Widget *> m_pending;
+    };
+
+    /// Return the parent window (or the widget itself if it is a window)
     Window *window();
 
-    /// Walk up the hierarchy and return the parent screen
+    /// Return the parent screen (or the widget itself if it is a screen)
     Screen *screen();
 
     /// Return whether or not this widget is currently enabled
@@ -180,8 +288,15 @@ public:
     /// Request the focus to be moved to this widget
     void request_focus();
 
-    const std::string &tooltip() const { return m_tooltip; }
-    void set_tooltip(const std::string &tooltip) { m_tooltip = tooltip; }
+    /**
+     * \brief Return a copy of the tooltip
+     *
+     * Tooltips are rare, hence they are stored outside of the widget. The
+     * copy remains valid if another thread changes the tooltip.
+     */
+    std::string tooltip() const;
+    /// Set the tooltip (an empty string removes it)
+    void set_tooltip(const std::string &tooltip);
 
     /// Return current font size. If not set the default of the current theme will be returned
     int font_size() const;
@@ -266,17 +381,38 @@ protected:
      */
     float icon_scale() const { return m_theme->m_icon_scale * m_icon_extra_scale; }
 
+    /**
+     * \brief Invalidate the cached absolute positions and visibility of this
+     * widget and its descendants
+     *
+     * Called by \ref set_position(), \ref set_visible() and \ref set_parent().
+     * Subclasses assigning \ref m_pos, \ref m_visible or \ref m_parent
+     * directly must call it as well.
+     */
+    void invalidate_cache();
+
+    /// Recompute the cached absolute position and visibility if necessary
+    void update_cache() const;
+
+    /**
+     * \brief Recompute the cached owning window and screen of this widget
+     * and its descendants
+     *
+     * Called by \ref set_parent() and by constructors adding \ref Kind flags.
+     */
+    void update_owners();
+
 protected:
+    /* Members accessed by every traversal come first, so that they share
+       the first cache line with the object header */
     Widget *m_parent;
-    ref<Theme> m_theme;
-    ref<Layout> m_layout;
-    Vector2i m_pos, m_size, m_fixed_size;
-    std::vector<Widget *> m_children;
+    Vector2i m_pos, m_size;
+
     /**
      * Whether or not this Widget is currently visible.  When a Widget is not
      * currently visible, no time is wasted executing its drawing method.
      */
-    bool m_visible;
+    bool m_visible : 1;
 
     /**
      * Whether or not this Widget is currently enabled.  Various different kinds
@@ -284,10 +420,28 @@ protected:
      * accepted.  For example, when ``m_enabled == false``, the state of a
      * CheckBox cannot be changed, or a TextBox will not allow new input.
      */
-    bool m_enabled;
-    bool m_focused, m_mouse_focus;
-    std::string m_tooltip;
+    bool m_enabled : 1;
+    bool m_focused : 1, m_mouse_focus : 1;
+    /// Whether a tooltip is set (see \ref tooltip())
+    bool m_has_tooltip : 1;
+    /// Cached visibility including the parents (see \ref update_cache())
+    mutable bool m_visible_recursive : 1;
+    /// Whether \ref m_absolute_pos and \ref m_visible_recursive are up to date
+    mutable bool m_cache_valid : 1;
+    /// \ref Kind flags of this widget
+    uint8_t m_kind;
     int m_font_size;
+    std::vector<Widget *> m_children;
+    /// Cached absolute position (see \ref update_cache())
+    mutable Vector2i m_absolute_pos;
+    /// Owning window and screen (see \ref update_owners())
+    Window *m_window;
+    Screen *m_screen;
+
+    /* Members that are rarely accessed */
+    ref<Theme> m_theme;
+    ref<Layout> m_layout;
+    Vector2i m_fixed_size;
 
     /**
      * \brief The amount of extra icon scaling used in addition the the theme's
@@ -77,7 +77,13 @@ void register_basics(py::module &m) {
         .def("set_items", (void(ComboBox::*)(const std::vector<std::string>&,
                           const std::vector<std::string>&)) &ComboBox::set_items/*, D(ComboBox, set_items, 2)*/)
         .def("items", &ComboBox::items, D(ComboBox, items))
-        .def("items_short", &ComboBox::items_short, D(ComboBox, items_short));
+        .def("items_short", &ComboBox::items_short, D(ComboBox, items_short))
+        .def("visible_rows", &ComboBox::visible_rows, D(ComboBox, visible_rows))
+        .def("set_visible_rows", &ComboBox::set_visible_rows, D(ComboBox, set_visible_rows))
+        .def("searchable", &ComboBox::searchable, D(ComboBox, searchable))
+        .def("filter", &ComboBox::filter, D(ComboBox, filter))
+        .def("set_filter", &ComboBox::set_filter, D(ComboBox, set_filter))
+        .def("match_count", &ComboBox::match_count, D(ComboBox, match_count));
 
     py::class_<ProgressBar, Widget, ref<ProgressBar>, PyProgressBar>(m, "ProgressBar", D(ProgressBar))
         .def(py::init<Widget *>(), "parent"_a, D(ProgressBar, ProgressBar))
@@ -18,7 +18,7 @@ from nanogui import Color, ColorPicker, Screen, Window, GroupLayout, BoxLayout,
                     ToolButton, Label, Button, Widget, \
                     Popup, PopupButton, CheckBox, MessageDialog, VScrollPanel, \
                     ImagePanel, ImageView, ComboBox, ProgressBar, Slider, \
-                    TextBox, ColorWheel, Graph, GridLayout, \
+                    TextBox, TextArea, ColorWheel, Graph, GridLayout, \
                     Alignment, Orientation, TabWidget, IntBox, GLShader
 
 from nanogui import gl, glfw, entypo
@@ -242,6 +242,20 @@ class TestApp(Screen):
                          0.5 * math.cos(i / 23.0) + 1)
                   for i in range(100)]
         graph.set_values(values)
+
+        layer = tab_widget.create_tab("Text Area")
+        layer.set_layout(GroupLayout())
+        Label(layer, "Multi-line text editor", "sans-bold")
+
+        text_area = TextArea(layer)
+        text_area.set_fixed_size((240, 140))
+        text_area.set_value("".join("Line %i of a longer document\n" % i
+                                    for i in range(1, 1001)))
+
+        def text_area_cb():
+            print("Text area now has %i lines" % text_area.line_count())
+        text_area.set_callback(text_area_cb)
+
         tab_widget.set_active_tab(0)
 
         # Dummy tab used to represent the last tab button.
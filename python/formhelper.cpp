@@ -4,10 +4,30 @@
 
 typedef IntBox<int64_t> Int64Box;
 
+/* Bind Property<Type> and the FormHelper method observing it */
+template <typename Type, typename WidgetType>
+void register_property(py::module &m, py::class_<FormHelper> &form_helper,
+                       const char *name, const char *method) {
+    py::class_<Property<Type>>(m, name, D(Property))
+        .def(py::init<const Type &>(), "value"_a, D(Property, Property))
+        .def("value", &Property<Type>::value, D(Property, value))
+        .def("set_value", &Property<Type>::set_value, D(Property, set_value));
+
+    /* The form refers to the property until the form is destroyed */
+    form_helper.def(method,
+        [](FormHelper &h, const std::string &label, Property<Type> &property,
+           bool editable) -> WidgetType * {
+            return h.add_variable(label, property, editable);
+        },
+        "label"_a, "property"_a, "editable"_a = true, py::keep_alive<1, 3>(),
+        D(FormHelper, add_variable_3));
+}
+
 void register_formhelper(py::module &m) {
     enum DummyEnum { };
 
-    py::class_<FormHelper>(m, "FormHelper", D(FormHelper))
+    py::class_<FormHelper> form_helper(m, "FormHelper", D(FormHelper));
+    form_helper
         .def(py::init<Screen *>(), D(FormHelper, FormHelper))
         .def("add_window", &FormHelper::add_window, "pos"_a,
              "title"_a = std::string("Untitled"),
@@ -82,5 +102,11 @@ void register_formhelper(py::module &m) {
         .def("set_label_font_size", &FormHelper::set_label_font_size, D(FormHelper, set_label_font_size))
         .def("widget_font_size", &FormHelper::widget_font_size, D(FormHelper, widget_font_size))
         .def("set_widget_font_size", &FormHelper::set_widget_font_size, D(FormHelper, set_widget_font_size));
+
+    register_property<bool, CheckBox>(m, form_helper, "BoolProperty", "add_bool_property");
+    register_property<int64_t, Int64Box>(m, form_helper, "IntProperty", "add_int_property");
+    register_property<double, FloatBox<double>>(m, form_helper, "DoubleProperty", "add_double_property");
+    register_property<std::string, TextBox>(m, form_helper, "StringProperty", "add_string_property");
+    register_property<Color, ColorPicker>(m, form_helper, "ColorProperty", "add_color_property");
 }
 #endif
@@ -844,28 +844,32 @@ long descriptive labels for each item)doc";
 
 static const char *__doc_nanogui_ComboBox_callback = R"doc(The callback to execute for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_filter = R"doc(The text that the items shown by the popup start with.)doc";
+
 static const char *__doc_nanogui_ComboBox_items = R"doc(The items associated with this ComboBox.)doc";
 
 static const char *__doc_nanogui_ComboBox_items_short = R"doc(The short descriptions associated with this ComboBox.)doc";
 
-static const char *__doc_nanogui_ComboBox_m_callback = R"doc(The callback for this ComboBox.)doc";
+static const char *__doc_nanogui_ComboBox_match_count = R"doc(The number of items shown by the popup with the current filter.)doc";
 
-static const char *__doc_nanogui_ComboBox_m_container = R"doc(Container containing the buttons)doc";
+static const char *__doc_nanogui_ComboBox_m_callback = R"doc(The callback for this ComboBox.)doc";
 
 static const char *__doc_nanogui_ComboBox_m_items = R"doc(The items associated with this ComboBox.)doc";
 
 static const char *__doc_nanogui_ComboBox_m_items_short = R"doc(The short descriptions of items associated with this ComboBox.)doc";
 
-static const char *__doc_nanogui_ComboBox_m_scroll = R"doc(Scroll panel used to store the combo box contents)doc";
-
 static const char *__doc_nanogui_ComboBox_m_selected_index = R"doc(The current index this ComboBox has selected.)doc";
 
 static const char *__doc_nanogui_ComboBox_scroll_event = R"doc(Handles mouse scrolling events for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_searchable = R"doc(Whether the popup shows a filter field (if there are more items than visible rows).)doc";
+
 static const char *__doc_nanogui_ComboBox_selected_index = R"doc(The current index this ComboBox has selected.)doc";
 
 static const char *__doc_nanogui_ComboBox_set_callback = R"doc(Sets the callback to execute for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_set_filter = R"doc(Only show the items starting with the given text (ignoring case) in the popup.)doc";
+
 static const char *__doc_nanogui_ComboBox_set_items =
 R"doc(Sets the items for this ComboBox, providing both short and long
 descriptive lables for each item.)doc";
@@ -874,6 +878,10 @@ static const char *__doc_nanogui_ComboBox_set_items_2 = R"doc(Sets the items for
 
 static const char *__doc_nanogui_ComboBox_set_selected_index = R"doc(Sets the current index this ComboBox has selected.)doc";
 
+static const char *__doc_nanogui_ComboBox_set_visible_rows = R"doc(Sets the maximum number of rows shown by the popup at once (requires a new layout).)doc";
+
+static const char *__doc_nanogui_ComboBox_visible_rows = R"doc(The maximum number of rows shown by the popup at once.)doc";
+
 static const char *__doc_nanogui_Cursor =
 R"doc(Cursor shapes available to use in GLFW. Shape of actual cursor
 determined by Operating System.)doc";
@@ -967,10 +975,22 @@ static const char *__doc_nanogui_FormHelper_add_button = R"doc(Add a button with
 
 static const char *__doc_nanogui_FormHelper_add_group = R"doc(Add a new group that may contain several sub-widgets)doc";
 
-static const char *__doc_nanogui_FormHelper_add_variable = R"doc(Add a new data widget controlled using custom getter/setter functions)doc";
+static const char *__doc_nanogui_FormHelper_add_variable =
+R"doc(Add a new data widget controlled using custom getter/setter functions
+
+refresh() calls the getter and only updates the widget when the
+returned value differs from the last value shown by the widget.)doc";
 
 static const char *__doc_nanogui_FormHelper_add_variable_2 = R"doc(Add a new data widget that exposes a raw variable in memory)doc";
 
+static const char *__doc_nanogui_FormHelper_add_variable_3 =
+R"doc(Add a new data widget that observes a Property
+
+Instead of being polled by refresh(), the property notifies the form
+when its value changes, and refresh() only updates the widgets of the
+properties that changed. A property can be bound to a single form at a
+time.)doc";
+
 static const char *__doc_nanogui_FormHelper_add_widget = R"doc(Add an arbitrary (optionally labeled) widget to the layout)doc";
 
 static const char *__doc_nanogui_FormHelper_add_window = R"doc(Add a new top-level window)doc";
@@ -1941,6 +1961,22 @@ static const char *__doc_nanogui_Popup_set_side = R"doc(Set the side of the pare
 
 static const char *__doc_nanogui_Popup_side = R"doc(Return the side of the parent window at which popup will appear)doc";
 
+static const char *__doc_nanogui_Property =
+R"doc(Variable that notifies the FormHelper it is bound to when its value
+changes.
+
+Assigning a different value marks the widget of the property for the
+next FormHelper::refresh(), which therefore costs time proportional to
+the number of changed properties rather than to the size of the form.
+Values must be assigned on the thread calling FormHelper::refresh()
+(use Screen::post() from other threads).)doc";
+
+static const char *__doc_nanogui_Property_Property = R"doc()doc";
+
+static const char *__doc_nanogui_Property_set_value = R"doc(Set the value and notify the form if it changed)doc";
+
+static const char *__doc_nanogui_Property_value = R"doc(Return the current value)doc";
+
 static const char *__doc_nanogui_ProgressBar = R"doc(Standard widget for visualizing progress.)doc";
 
 static const char *__doc_nanogui_ProgressBar_ProgressBar = R"doc()doc";
@@ -2494,6 +2530,51 @@ static const char *__doc_nanogui_TabWidget_tab_label_index =
 R"doc(Retrieves the index of a specific tab using its tab label. Returns -1
 if there is no such tab.)doc";
 
+static const char *__doc_nanogui_TextArea =
+R"doc(Multi-line text editor and viewer for large documents.
+
+The UTF-8 text is stored in a gap buffer: the unused space of the buffer
+is kept at the last edit position, hence typing only moves the bytes
+between consecutive edit positions. The start of every line is stored in
+a second gap buffer, where lines in front of the gap store their offset
+from the beginning of the text and lines behind it their offset from the
+end, so that edits do not have to update the lines that follow. Looking
+up the line containing a position is a binary search.
+
+Only the visible lines are drawn, and the caret positions of every
+visible line are measured once and cached until the line changes. Lines
+are not wrapped; long lines scroll horizontally.)doc";
+
+static const char *__doc_nanogui_TextArea_TextArea = R"doc()doc";
+
+static const char *__doc_nanogui_TextArea_append = R"doc(Append text at the end (e.g. log output); keeps the view at the end if it was there)doc";
+
+static const char *__doc_nanogui_TextArea_callback = R"doc(The callback to execute when the user has changed the text)doc";
+
+static const char *__doc_nanogui_TextArea_cursor_pos = R"doc(Return the byte offset of the cursor)doc";
+
+static const char *__doc_nanogui_TextArea_editable = R"doc(Can the text be edited?)doc";
+
+static const char *__doc_nanogui_TextArea_insert = R"doc(Insert text at the cursor, replacing the selection)doc";
+
+static const char *__doc_nanogui_TextArea_line = R"doc(Return the given line without its line break)doc";
+
+static const char *__doc_nanogui_TextArea_line_count = R"doc(Return the number of lines)doc";
+
+static const char *__doc_nanogui_TextArea_selection = R"doc(Return the selected text)doc";
+
+static const char *__doc_nanogui_TextArea_set_callback = R"doc(Set the callback to execute when the user has changed the text)doc";
+
+static const char *__doc_nanogui_TextArea_set_cursor_pos = R"doc(Move the cursor (and clear the selection))doc";
+
+static const char *__doc_nanogui_TextArea_set_editable = R"doc(Specify whether the text can be edited)doc";
+
+static const char *__doc_nanogui_TextArea_set_value = R"doc(Replace the text (moves the cursor to the beginning))doc";
+
+static const char *__doc_nanogui_TextArea_size = R"doc(Return the size of the text in bytes)doc";
+
+static const char *__doc_nanogui_TextArea_value = R"doc(Return a copy of the text)doc";
+
 static const char *__doc_nanogui_TextBox =
 R"doc(Fancy text box with builtin regular expression-based validation.
 
@@ -2617,7 +2698,14 @@ static const char *__doc_nanogui_TextBox_set_default_value = R"doc()doc";
 
 static const char *__doc_nanogui_TextBox_set_editable = R"doc()doc";
 
-static const char *__doc_nanogui_TextBox_set_format = R"doc(Specify a regular expression specifying valid formats)doc";
+static const char *__doc_nanogui_TextBox_set_format =
+R"doc(Specify a regular expression specifying valid formats
+
+The expression is compiled once here rather than whenever the value is
+validated. Compiled expressions are shared by all text boxes using the
+same format, and the formats of IntBox and FloatBox are validated by
+hand-written matchers. Throws an exception if the expression is
+invalid.)doc";
 
 static const char *__doc_nanogui_TextBox_set_placeholder =
 R"doc(Specify a placeholder text to be displayed while the text box is
@@ -2800,6 +2888,8 @@ static const char *__doc_nanogui_Theme_m_text_color_shadow =
 R"doc(The text shadow color (default: intensity=``0``, alpha=``160``; see
 nanogui::Color::Color(int,int)).)doc";
 
+static const char *__doc_nanogui_Theme_m_tooltip_font_size = R"doc(The font size for tooltips (default: ``15``).)doc";
+
 static const char *__doc_nanogui_Theme_m_transparent =
 R"doc(The transparency color (default: intensity=``0``, alpha=``0``; see
 nanogui::Color::Color(int,int)).)doc";
@@ -2848,6 +2938,10 @@ static const char *__doc_nanogui_Theme_m_window_title_focused =
 R"doc(The title color for a Window that is in focus (default:
 intensity=``255``, alpha=``190``; see nanogui::Color::Color(int,int)).)doc";
 
+static const char *__doc_nanogui_Theme_m_window_title_font_size = R"doc(The font size for Window titles (default: ``18``).)doc";
+
+static const char *__doc_nanogui_Theme_m_window_title_shadow_blur = R"doc(Blur radius of the shadow behind Window titles (default: ``2``).)doc";
+
 static const char *__doc_nanogui_Theme_m_window_title_unfocused =
 R"doc(The title color for a Window that is not in focus (default:
 intensity=``220``, alpha=``160``; see nanogui::Color::Color(int,int)).)doc";
@@ -2908,6 +3002,14 @@ parent)doc";
 
 static const char *__doc_nanogui_Widget_add_child_2 = R"doc(Convenience function which appends a widget at the end)doc";
 
+static const char *__doc_nanogui_Widget_add_children =
+R"doc(Add several existing child widgets at the specified index
+
+The widgets are inserted with a single reallocation of the list of
+children, and the theme is propagated to each of their subtrees once.
+Subclasses overriding add_child() must override this function as
+well, since the default implementation does not call add_child().)doc";
+
 static const char *__doc_nanogui_Widget_child_at = R"doc(Retrieves the child at the specific position)doc";
 
 static const char *__doc_nanogui_Widget_child_at_2 = R"doc(Retrieves the child at the specific position)doc";
@@ -6,6 +6,7 @@ typedef FloatBox<double> DoubleBox;
 typedef IntBox<int64_t> Int64Box;
 
 DECLARE_WIDGET(TextBox);
+DECLARE_WIDGET(TextArea);
 DECLARE_WIDGET(DoubleBox);
 DECLARE_WIDGET(Int64Box);
 
@@ -40,6 +41,23 @@ void register_textbox(py::module &m) {
         .value("Center", TextBox::Alignment::Center)
         .value("Right", TextBox::Alignment::Right);
 
+    py::class_<TextArea, Widget, ref<TextArea>, PyTextArea>(m, "TextArea", D(TextArea))
+        .def(py::init<Widget *>(), "parent"_a, D(TextArea, TextArea))
+        .def("value", &TextArea::value, D(TextArea, value))
+        .def("set_value", &TextArea::set_value, D(TextArea, set_value))
+        .def("insert", &TextArea::insert, D(TextArea, insert))
+        .def("append", &TextArea::append, D(TextArea, append))
+        .def("size", &TextArea::size, D(TextArea, size))
+        .def("line_count", &TextArea::line_count, D(TextArea, line_count))
+        .def("line", &TextArea::line, "index"_a, D(TextArea, line))
+        .def("editable", &TextArea::editable, D(TextArea, editable))
+        .def("set_editable", &TextArea::set_editable, D(TextArea, set_editable))
+        .def("cursor_pos", &TextArea::cursor_pos, D(TextArea, cursor_pos))
+        .def("set_cursor_pos", &TextArea::set_cursor_pos, D(TextArea, set_cursor_pos))
+        .def("selection", &TextArea::selection, D(TextArea, selection))
+        .def("callback", &TextArea::callback, D(TextArea, callback))
+        .def("set_callback", &TextArea::set_callback, D(TextArea, set_callback));
+
     py::class_<Int64Box, TextBox, ref<Int64Box>, PyInt64Box>(m, "IntBox", D(IntBox))
         .def(py::init<Widget *, int64_t>(), "parent"_a, "value"_a = (int64_t) 0, D(IntBox, IntBox))
         .def("value", &Int64Box::value, D(IntBox, value))
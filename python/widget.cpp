@@ -37,6 +37,9 @@ void register_widget(py::module &m) {
              D(Widget, children), py::return_value_policy::reference)
         .def("add_child", (void (Widget::*) (int, Widget *)) &Widget::add_child, D(Widget, add_child))
         .def("add_child", (void (Widget::*) (Widget *)) &Widget::add_child, D(Widget, add_child, 2))
+        .def("add_children", [](Widget &w, int index, const std::vector<Widget *> &widgets) {
+                 w.add_children(index, widgets.data(), widgets.size());
+             }, "index"_a, "widgets"_a, D(Widget, add_children))
         .def("child_count", &Widget::child_count, D(Widget, child_count))
         .def("__len__", &Widget::child_count, D(Widget, child_count))
         .def("__iter__", [](const Widget &w) {
@@ -0,0 +1,145 @@
+/*
+    resources/compression.h -- Minimal LZ4 block codec used to store
+    embedded resources in compressed form
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/* The data is stored in the LZ4 block format: a sequence of tokens, each
+   containing a run of literals followed by a back-reference of at least 4
+   bytes into the already decoded output. The last 5 bytes are always
+   literals. Decoding is a simple byte copy loop that requires no tables. */
+
+/// Compress 'size' bytes from 'src' (used at build time by nanogui-rescomp)
+inline std::vector<uint8_t> nanogui_lz4_compress(const uint8_t *src, size_t size) {
+    const size_t hash_bits = 16, min_match = 4, last_literals = 5,
+                 max_offset = 65535;
+    std::vector<uint32_t> table(size_t(1) << hash_bits, UINT32_MAX);
+    std::vector<uint8_t> out;
+    out.reserve(size + size / 255 + 16);
+
+    auto read32 = [&](size_t i) { uint32_t v; memcpy(&v, src + i, 4); return v; };
+    auto hash = [&](size_t i) {
+        return (read32(i) * 2654435761u) >> (32 - hash_bits);
+    };
+    auto put_length = [&](size_t length) {
+        for (; length >= 255; length -= 255)
+            out.push_back(255);
+        out.push_back((uint8_t) length);
+    };
+    auto put_sequence = [&](size_t lit_start, size_t lit_end, size_t offset,
+                            size_t match_length) {
+        size_t lit_length = lit_end - lit_start;
+        size_t ml = match_length ? match_length - min_match : 0;
+        out.push_back((uint8_t) (((lit_length < 15 ? lit_length : 15) << 4) |
+                                 (ml < 15 ? ml : 15)));
+        if (lit_length >= 15)
+            put_length(lit_length - 15);
+        out.insert(out.end(), src + lit_start, src + lit_end);
+        if (!match_length)
+            return;
+        out.push_back((uint8_t) offset);
+        out.push_back((uint8_t) (offset >> 8));
+        if (ml >= 15)
+            put_length(ml - 15);
+    };
+
+    size_t anchor = 0, i = 0;
+    /* The last match must start at least 12 bytes before the end */
+    size_t match_limit = size > 12 ? size - 12 : 0;
+
+    while (i < match_limit) {
+        uint32_t h = (uint32_t) hash(i);
+        size_t candidate = table[h];
+        table[h] = (uint32_t) i;
+
+        if (candidate == UINT32_MAX || i - candidate > max_offset ||
+            read32(candidate) != read32(i)) {
+            ++i;
+            continue;
+        }
+
+        size_t length = min_match;
+        while (i + length < size - last_literals &&
+               src[candidate + length] == src[i + length])
+            ++length;
+
+        put_sequence(anchor, i, i - candidate, length);
+        i += length;
+        anchor = i;
+    }
+
+    put_sequence(anchor, size, 0, 0);
+    return out;
+}
+
+/**
+ * Decompress an LZ4 block into 'dst', which must hold exactly 'dst_size'
+ * bytes. Returns false when the input is malformed.
+ */
+inline bool nanogui_lz4_decompress(const uint8_t *src, size_t src_size,
+                                   uint8_t *dst, size_t dst_size) {
+    const uint8_t *src_end = src + src_size;
+    uint8_t *out = dst, *out_end = dst + dst_size;
+
+    auto get_length = [&](size_t &length) {
+        uint8_t value;
+        do {
+            if (src == src_end)
+                return false;
+            value = *src++;
+            length += value;
+        } while (value == 255);
+        return true;
+    };
+
+    while (src < src_end) {
+        uint8_t token = *src++;
+
+        size_t lit_length = token >> 4;
+        if (lit_length == 15 && !get_length(lit_length))
+            return false;
+        if ((size_t) (src_end - src) < lit_length ||
+            (size_t) (out_end - out) < lit_length)
+            return false;
+        memcpy(out, src, lit_length);
+        src += lit_length;
+        out += lit_length;
+
+        if (src == src_end)
+            break; /* The last sequence has no match */
+
+        if (src_end - src < 2)
+            return false;
+        size_t offset = src[0] | ((size_t) src[1] << 8);
+        src += 2;
+
+        size_t match_length = token & 15;
+        if (match_length == 15 && !get_length(match_length))
+            return false;
+        match_length += 4;
+
+        if (offset == 0 || offset > (size_t) (out - dst) ||
+            (size_t) (out_end - out) < match_length)
+            return false;
+
+        /* Byte-wise copy: the source and destination ranges may overlap */
+        const uint8_t *match = out - offset;
+        for (size_t j = 0; j < match_length; ++j)
+            out[j] = match[j];
+        out += match_length;
+    }
+
+    return out == out_end;
+}
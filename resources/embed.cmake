@@ -0,0 +1,154 @@
+cmake_minimum_required (VERSION 3.12)
+
+# Embeds binary resource files into a C++ source file. The bytes are pulled in
+# by the assembler (.incbin) or the preprocessor (#embed) rather than being
+# converted into a textual array, which keeps both this script and the
+# compilation of the generated file fast. Compilers supporting neither (MSVC)
+# fall back to a hexadecimal array.
+#
+# Every resource 'dir/Name-X.ttf' yields the symbols
+#
+#   uint8_t name_x_ttf[];      (contents followed by a zero byte)
+#   uint32_t name_x_ttf_size;  (size excluding the zero byte)
+#
+# When COMPRESSED_DIR is specified, the file 'COMPRESSED_DIR/Name-X.ttf.lz4'
+# (generated by nanogui-rescomp) is embedded instead. The arrays are then
+# zero-initialized and filled on the first call to nanogui_resources_load().
+#
+# Parameters: OUTPUT_C, OUTPUT_H, INPUT_FILES (comma separated),
+#             EMBED_HEX (set for compilers without .incbin/#embed support),
+#             COMPRESSED_DIR (optional), COMPRESSION_H (required if compressed)
+
+function(file_size filename result)
+  if (CMAKE_VERSION VERSION_LESS 3.14)
+    file(READ ${filename} data HEX)
+    string(LENGTH "${data}" length)
+    math(EXPR length "${length} / 2")
+  else()
+    file(SIZE ${filename} length)
+  endif()
+  set(${result} ${length} PARENT_SCOPE)
+endfunction()
+
+# Emit a definition of the array 'symbol' containing the bytes of 'bin'
+# followed by a zero byte
+function(embed_file bin symbol qualifiers result)
+  if (EMBED_HEX)
+    # Slow path: read hex data from file and convert it for C compatibility
+    file(READ ${bin} filedata HEX)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," filedata "${filedata}00")
+    set(${result} "${qualifiers} uint8_t ${symbol}[] = {${filedata}};\n\n" PARENT_SCOPE)
+    return()
+  endif()
+  string(CONCAT value
+    "#if defined(NANOGUI_EMBED_ASM)\n"
+    "NANOGUI_EMBED_ASM(${symbol}, \"${bin}\")\n"
+    "extern ${qualifiers} uint8_t ${symbol}[];\n"
+    "#elif defined(NANOGUI_EMBED_PP)\n"
+    "${qualifiers} uint8_t ${symbol}[] = {\n"
+    "#embed \"${bin}\"\n"
+    ", 0 };\n"
+    "#else\n"
+    "#  error \"No support for .incbin or #embed, reconfigure with EMBED_HEX\"\n"
+    "#endif\n\n")
+  set(${result} "${value}" PARENT_SCOPE)
+endfunction()
+
+string(CONCAT source
+  "/* Autogenerated by resources/embed.cmake */\n\n"
+  "#include <stdint.h>\n"
+  "#include \"nanogui_resources.h\"\n\n"
+  "#if defined(__has_embed)\n"
+  "#  define NANOGUI_EMBED_PP\n"
+  "#elif defined(__GNUC__) || defined(__clang__)\n"
+  "#  define NANOGUI_EMBED_STR2(x) #x\n"
+  "#  define NANOGUI_EMBED_STR(x) NANOGUI_EMBED_STR2(x)\n"
+  "#  define NANOGUI_EMBED_SYM(name) NANOGUI_EMBED_STR(__USER_LABEL_PREFIX__) #name\n"
+  "#  if defined(__APPLE__)\n"
+  "#    define NANOGUI_EMBED_SECTION \".const_data\\n\"\n"
+  "#    define NANOGUI_EMBED_HIDDEN(name) \".private_extern \" NANOGUI_EMBED_SYM(name) \"\\n\"\n"
+  "#  elif defined(_WIN32)\n"
+  "#    define NANOGUI_EMBED_SECTION \".section .rdata,\\\"dr\\\"\\n\"\n"
+  "#    define NANOGUI_EMBED_HIDDEN(name)\n"
+  "#  else\n"
+  "#    define NANOGUI_EMBED_SECTION \".section .rodata\\n\"\n"
+  "#    define NANOGUI_EMBED_HIDDEN(name) \".hidden \" NANOGUI_EMBED_SYM(name) \"\\n\"\n"
+  "#  endif\n"
+  "#  define NANOGUI_EMBED_ASM(name, filename) __asm__(                 \\\n"
+  "       NANOGUI_EMBED_SECTION                                        \\\n"
+  "       \".global \" NANOGUI_EMBED_SYM(name) \"\\n\"                      \\\n"
+  "       NANOGUI_EMBED_HIDDEN(name)                                   \\\n"
+  "       \".balign 16\\n\"                                              \\\n"
+  "       NANOGUI_EMBED_SYM(name) \":\\n\"                                \\\n"
+  "       \".incbin \\\"\" filename \"\\\"\\n\"                               \\\n"
+  "       \".byte 0\\n\"                                                 \\\n"
+  "       \".text\\n\");\n"
+  "#endif\n\n")
+
+string(CONCAT header
+  "/* Autogenerated by resources/embed.cmake */\n\n"
+  "#pragma once\n"
+  "#include <stdint.h>\n\n")
+
+string(REPLACE "," ";" INPUT_LIST ${INPUT_FILES})
+
+if (COMPRESSED_DIR)
+  string(APPEND source
+    "#include \"${COMPRESSION_H}\"\n"
+    "#include <mutex>\n"
+    "#include <stdexcept>\n\n")
+  set(load_body "")
+  string(CONCAT header_load
+    "/// Decompresses the resources above. Must be called before accessing them.\n"
+    "extern void nanogui_resources_load();\n")
+else()
+  string(CONCAT header_load
+    "/// Resources are stored uncompressed, so there is nothing to load\n"
+    "inline void nanogui_resources_load() { }\n")
+endif()
+
+foreach(bin ${INPUT_LIST})
+  # Get short filename
+  string(REGEX MATCH "([^/]+)$" basename ${bin})
+  # Replace filename spaces & extension separator for C compatibility
+  string(REGEX REPLACE "\\.| |-" "_" filename ${basename})
+  # Convert to lower case
+  string(TOLOWER ${filename} filename)
+
+  file_size(${bin} size)
+
+  if (COMPRESSED_DIR)
+    set(compressed "${COMPRESSED_DIR}/${basename}.lz4")
+    file_size(${compressed} compressed_size)
+    embed_file(${compressed} nanogui_lz4_${filename} "const" embedded)
+    string(APPEND source "${embedded}"
+      "uint8_t ${filename}[${size} + 1];\n"
+      "uint32_t ${filename}_size = ${size};\n\n")
+    string(APPEND load_body
+      "        if (!nanogui_lz4_decompress(nanogui_lz4_${filename}, ${compressed_size},\n"
+      "                                    ${filename}, ${size}))\n"
+      "            throw std::runtime_error(\"Could not decompress resource \\\"${basename}\\\"!\");\n")
+  else()
+    embed_file(${bin} ${filename} "" embedded)
+    string(APPEND source "${embedded}"
+      "uint32_t ${filename}_size = ${size};\n\n")
+  endif()
+
+  # Append extern definitions to h file
+  string(APPEND header "extern uint8_t ${filename}[];\n\nextern uint32_t ${filename}_size;\n\n")
+endforeach()
+
+if (COMPRESSED_DIR)
+  string(APPEND source
+    "void nanogui_resources_load() {\n"
+    "    static std::once_flag flag;\n"
+    "    std::call_once(flag, [] {\n"
+    "${load_body}"
+    "    });\n"
+    "}\n")
+endif()
+
+string(APPEND header "${header_load}")
+
+file(WRITE ${OUTPUT_C} "${source}")
+file(WRITE ${OUTPUT_H} "${header}")
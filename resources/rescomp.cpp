@@ -0,0 +1,52 @@
+/*
+    resources/rescomp.cpp -- Build-time tool that compresses resource files
+    before they are embedded into the NanoGUI library
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include "compression.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::cerr << "Syntax: " << argv[0] << " <input> <output>" << std::endl;
+        return -1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Could not open \"" << argv[1] << "\"!" << std::endl;
+        return -1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+
+    std::vector<uint8_t> compressed =
+        nanogui_lz4_compress(data.data(), data.size());
+
+    std::vector<uint8_t> check(data.size());
+    if (!nanogui_lz4_decompress(compressed.data(), compressed.size(),
+                                check.data(), check.size()) ||
+        check != data) {
+        std::cerr << "Round trip of \"" << argv[1] << "\" failed!" << std::endl;
+        return -1;
+    }
+
+    std::ofstream out(argv[2], std::ios::binary);
+    out.write((const char *) compressed.data(), (std::streamsize) compressed.size());
+    if (!out) {
+        std::cerr << "Could not write \"" << argv[2] << "\"!" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
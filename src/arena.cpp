@@ -0,0 +1,124 @@
+/*
+    src/arena.cpp -- Pool allocator for widgets and other objects
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/arena.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(nanogui)
+
+static thread_local Arena *current_arena = nullptr;
+
+/* Arenas by the index (address / slab_alignment) of every aligned chunk of
+   their slabs. Allocated once and never destroyed, since objects may be
+   released during static destruction */
+struct SlabTable {
+    std::unordered_map<uintptr_t, Arena *> arenas;
+    std::shared_mutex mutex;
+};
+
+static SlabTable &slab_table() {
+    static SlabTable *table = new SlabTable();
+    return *table;
+}
+
+/// Number of registered slabs (owner() skips the table while there are none)
+static std::atomic<size_t> slab_count { 0 };
+
+Arena::Arena(size_t slab_size)
+    : m_slab_size((std::max(slab_size, max_block_size) + slab_alignment - 1) /
+                  slab_alignment * slab_alignment) { }
+
+Arena::~Arena() {
+    SlabTable &table = slab_table();
+    {
+        std::unique_lock<std::shared_mutex> guard(table.mutex);
+        for (char *slab : m_slabs)
+            for (size_t offset = 0; offset < m_slab_size; offset += slab_alignment)
+                table.arenas.erase((uintptr_t) (slab + offset) / slab_alignment);
+    }
+    slab_count -= m_slabs.size();
+
+    for (char *slab : m_slabs)
+        ::operator delete(slab, std::align_val_t(slab_alignment));
+}
+
+void *Arena::allocate(size_t size) {
+    if (size > max_block_size)
+        throw std::runtime_error("Arena::allocate(): block size exceeds max_block_size!");
+
+    size_t index = size_class(size);
+    size = index * granularity;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_allocated += size;
+    if (void *block = m_free[index]) {
+        m_free[index] = *(void **) block;
+        return block;
+    }
+
+    if (m_next + size > m_end) {
+        /* The rest of the current slab is too small: start a new one */
+        char *slab = (char *) ::operator new(m_slab_size, std::align_val_t(slab_alignment));
+        try {
+            SlabTable &table = slab_table();
+            std::unique_lock<std::shared_mutex> guard2(table.mutex);
+            for (size_t offset = 0; offset < m_slab_size; offset += slab_alignment)
+                table.arenas[(uintptr_t) (slab + offset) / slab_alignment] = this;
+            m_slabs.push_back(slab);
+        } catch (...) {
+            ::operator delete(slab, std::align_val_t(slab_alignment));
+            m_allocated -= size;
+            throw;
+        }
+        slab_count++;
+        m_next = slab;
+        m_end = slab + m_slab_size;
+    }
+    void *block = m_next;
+    m_next += size;
+    return block;
+}
+
+void Arena::deallocate(void *ptr, size_t size) noexcept {
+    size_t index = size_class(size);
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_allocated -= index * granularity;
+    *(void **) ptr = m_free[index];
+    m_free[index] = ptr;
+}
+
+Arena *Arena::owner(const void *ptr) noexcept {
+    if (slab_count.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+    SlabTable &table = slab_table();
+    std::shared_lock<std::shared_mutex> guard(table.mutex);
+    auto it = table.arenas.find((uintptr_t) ptr / slab_alignment);
+    return it != table.arenas.end() ? it->second : nullptr;
+}
+
+Arena *Arena::current() {
+    return current_arena;
+}
+
+Arena::Scope::Scope(Arena *arena) : m_arena(arena), m_previous(current_arena) {
+    current_arena = arena;
+}
+
+Arena::Scope::~Scope() {
+    current_arena = m_previous;
+}
+
+NAMESPACE_END(nanogui)
@@ -11,31 +11,282 @@
 
 #include <nanogui/combobox.h>
 #include <nanogui/layout.h>
-#include <nanogui/vscrollpanel.h>
+#include <nanogui/theme.h>
+#include <nanogui/opengl.h>
+#include <algorithm>
+#include <numeric>
 #include <cassert>
 
 NAMESPACE_BEGIN(nanogui)
 
+static std::string to_lower(const std::string &str) {
+    std::string result(str);
+    for (char &c : result) {
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+    }
+    return result;
+}
+
+/**
+ * Draws the visible rows of a combo box popup straight from the item list,
+ * with a filter field on top if the combo box is searchable.
+ */
+class ComboBox::List : public Widget {
+public:
+    List(ComboBox *combo) : Widget(combo->popup()), m_combo(combo) { }
+
+    /// Called when the popup opens: clear the filter and show the selected item
+    void open() {
+        m_combo->set_filter("");
+        m_highlight = m_combo->m_selected_index;
+        m_scroll = 0;
+        request_focus();
+        if (m_highlight >= 0)
+            scroll_to(m_highlight);
+    }
+
+    virtual Vector2i preferred_size(NVGcontext *) const override {
+        int rows = std::max(1, std::min((int) m_combo->m_items.size(),
+                                        m_combo->m_visible_rows));
+        return Vector2i(std::max(m_combo->width(), 150),
+                        header_height() + rows * row_height());
+    }
+
+    virtual void draw(NVGcontext *ctx) override {
+        int rh = row_height(), header = header_height();
+        float view_h = (float) (m_size.y() - header),
+              content = (float) (m_combo->match_count() * rh);
+        bool scrollbar = content > view_h;
+        m_scroll = std::max(0.f, std::min(m_scroll, content - view_h));
+
+        nvgSave(ctx);
+        nvgFontSize(ctx, m_theme->m_button_font_size);
+        nvgFontFace(ctx, "sans");
+        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+
+        if (header > 0) {
+            NVGpaint bg = nvgBoxGradient(ctx, m_pos.x() + 1, m_pos.y() + 2,
+                                         m_size.x() - 2, rh - 2, 3, 4,
+                                         Color(255, 32), Color(32, 32));
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, m_pos.x() + 1, m_pos.y() + 2, m_size.x() - 2, rh - 2, 3);
+            nvgFillPaint(ctx, bg);
+            nvgFill(ctx);
+
+            const std::string &filter = m_combo->m_filter;
+            nvgFillColor(ctx, filter.empty() ? m_theme->m_disabled_text_color
+                                             : m_theme->m_text_color);
+            nvgText(ctx, m_pos.x() + 6, m_pos.y() + 1 + rh * 0.5f,
+                    filter.empty() ? "Type to filter" : filter.c_str(), nullptr);
+        }
+
+        float row_w = m_size.x() - (scrollbar ? 14.f : 0.f), y0 = (float) (m_pos.y() + header);
+        nvgIntersectScissor(ctx, m_pos.x(), y0, row_w, view_h);
+
+        size_t first = (size_t) (m_scroll / rh),
+               last = std::min(m_combo->match_count(),
+                               (size_t) std::ceil((m_scroll + view_h) / rh));
+        for (size_t row = first; row < last; ++row) {
+            int item = m_combo->row_item(row);
+            float y = y0 + row * rh - m_scroll;
+
+            bool selected = item == m_combo->m_selected_index,
+                 highlighted = (int) row == m_highlight;
+            if (selected || highlighted) {
+                NVGpaint bg = nvgLinearGradient(
+                    ctx, m_pos.x(), y, m_pos.x(), y + rh,
+                    selected ? m_theme->m_button_gradient_top_pushed : m_theme->m_button_gradient_top_focused,
+                    selected ? m_theme->m_button_gradient_bot_pushed : m_theme->m_button_gradient_bot_focused);
+                nvgBeginPath(ctx);
+                nvgRoundedRect(ctx, m_pos.x() + 1, y + 1, row_w - 2, rh - 2,
+                               m_theme->m_button_corner_radius);
+                nvgFillPaint(ctx, bg);
+                nvgFill(ctx);
+            }
+
+            nvgFillColor(ctx, m_theme->m_text_color);
+            nvgText(ctx, m_pos.x() + 10, y + rh * 0.5f, m_combo->m_items[item].c_str(), nullptr);
+        }
+        nvgRestore(ctx);
+
+        if (!scrollbar)
+            return;
+
+        float scrollh = std::max(16.f, view_h * view_h / content),
+              scroll = m_scroll / (content - view_h);
+        NVGpaint paint = nvgBoxGradient(
+            ctx, m_pos.x() + m_size.x() - 12 + 1, y0 + 4 + 1, 8,
+            view_h - 8, 3, 4, Color(0, 32), Color(0, 92));
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, m_pos.x() + m_size.x() - 12, y0 + 4, 8, view_h - 8, 3);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+
+        paint = nvgBoxGradient(
+            ctx, m_pos.x() + m_size.x() - 12 - 1,
+            y0 + 4 + (view_h - 8 - scrollh) * scroll - 1, 8, scrollh,
+            3, 4, Color(220, 100), Color(128, 100));
+        nvgBeginPath(ctx);
+        nvgRoundedRect(ctx, m_pos.x() + m_size.x() - 12 + 1,
+                       y0 + 4 + 1 + (view_h - 8 - scrollh) * scroll, 8 - 2,
+                       scrollh - 2, 2);
+        nvgFillPaint(ctx, paint);
+        nvgFill(ctx);
+    }
+
+    virtual bool mouse_motion_event(const Vector2i &p, const Vector2i &, int, int) override {
+        int row = row_at(p);
+        if (row >= 0)
+            m_highlight = row;
+        return true;
+    }
+
+    virtual bool mouse_button_event(const Vector2i &p, int button, bool down, int) override {
+        if (button != GLFW_MOUSE_BUTTON_1)
+            return false;
+        m_drag_scrollbar = false;
+        if (!down)
+            return true;
+
+        if (p.x() >= m_pos.x() + m_size.x() - 14 && p.y() >= m_pos.y() + header_height()) {
+            m_drag_scrollbar = true;
+            return true;
+        }
+        int row = row_at(p);
+        if (row >= 0)
+            m_combo->choose(m_combo->row_item((size_t) row));
+        return true;
+    }
+
+    virtual bool mouse_drag_event(const Vector2i &, const Vector2i &rel, int, int) override {
+        if (!m_drag_scrollbar)
+            return false;
+        float view_h = (float) (m_size.y() - header_height()),
+              content = (float) (m_combo->match_count() * row_height()),
+              scrollh = std::max(16.f, view_h * view_h / content);
+        if (content > view_h)
+            m_scroll += rel.y() * (content - view_h) / (view_h - 8 - scrollh);
+        return true;
+    }
+
+    virtual bool scroll_event(const Vector2i &, const Vector2f &rel) override {
+        m_scroll = std::max(0.f, m_scroll - rel.y() * row_height() * 3);
+        return true;
+    }
+
+    virtual bool keyboard_event(int key, int, int action, int) override {
+        if (!m_combo->pushed())
+            return false;
+        if (action != GLFW_PRESS && action != GLFW_REPEAT)
+            return true;
+
+        int page = std::max(1, (m_size.y() - header_height()) / row_height());
+        switch (key) {
+            case GLFW_KEY_UP:        move_highlight(-1); break;
+            case GLFW_KEY_DOWN:      move_highlight(1); break;
+            case GLFW_KEY_PAGE_UP:   move_highlight(-page); break;
+            case GLFW_KEY_PAGE_DOWN: move_highlight(page); break;
+            case GLFW_KEY_ESCAPE:    m_combo->set_pushed(false); break;
+
+            case GLFW_KEY_ENTER:
+            case GLFW_KEY_KP_ENTER:
+                if (m_highlight >= 0 && m_highlight < (int) m_combo->match_count())
+                    m_combo->choose(m_combo->row_item((size_t) m_highlight));
+                break;
+
+            case GLFW_KEY_BACKSPACE: {
+                    std::string filter = m_combo->m_filter;
+                    if (filter.empty())
+                        break;
+                    /* Remove the last UTF-8 character */
+                    size_t pos = filter.size() - 1;
+                    while (pos > 0 && (filter[pos] & 0xC0) == 0x80)
+                        --pos;
+                    filter.resize(pos);
+                    set_filter(filter);
+                }
+                break;
+
+            default:
+                break;
+        }
+        return true;
+    }
+
+    virtual bool keyboard_character_event(unsigned int codepoint) override {
+        if (!m_combo->pushed() || !m_combo->searchable())
+            return false;
+        set_filter(m_combo->m_filter + utf8((int) codepoint).data());
+        return true;
+    }
+
+protected:
+    int row_height() const { return m_theme->m_button_font_size + 10; }
+
+    int header_height() const {
+        return m_combo->searchable() ? row_height() + 4 : 0;
+    }
+
+    /// Return the row at the given position (in parent coordinates) or -1
+    int row_at(const Vector2i &p) const {
+        int y = p.y() - m_pos.y() - header_height();
+        if (y < 0)
+            return -1;
+        size_t row = (size_t) ((y + m_scroll) / row_height());
+        return row < m_combo->match_count() ? (int) row : -1;
+    }
+
+    void set_filter(const std::string &filter) {
+        m_combo->set_filter(filter);
+        m_highlight = 0;
+        m_scroll = 0;
+    }
+
+    void move_highlight(int delta) {
+        int count = (int) m_combo->match_count();
+        if (count == 0)
+            return;
+        m_highlight = std::max(0, std::min(count - 1, m_highlight + delta));
+        scroll_to(m_highlight);
+    }
+
+    void scroll_to(int row) {
+        float rh = (float) row_height(),
+              view_h = (float) (m_size.y() - header_height());
+        if (row * rh < m_scroll)
+            m_scroll = row * rh;
+        else if ((row + 1) * rh > m_scroll + view_h)
+            m_scroll = (row + 1) * rh - view_h;
+    }
+
+protected:
+    ComboBox *m_combo;
+    /// Row under the mouse or selected with the keyboard
+    int m_highlight = -1;
+    /// Scroll offset of the rows in pixels
+    float m_scroll = 0.f;
+    bool m_drag_scrollbar = false;
+};
+
 ComboBox::ComboBox(Widget *parent)
-    : PopupButton(parent), m_container(popup()), m_selected_index(0) {
+    : ComboBox(parent, { }, { }) {
 }
 
 ComboBox::ComboBox(Widget *parent, const std::vector<std::string> &items)
-    : PopupButton(parent), m_container(popup()), m_selected_index(0) {
-    set_items(items);
+    : ComboBox(parent, items, items) {
 }
 
 ComboBox::ComboBox(Widget *parent, const std::vector<std::string> &items, const std::vector<std::string> &items_short)
-    : PopupButton(parent), m_container(popup()), m_selected_index(0) {
+    : PopupButton(parent), m_selected_index(0) {
+    m_popup->set_layout(new BoxLayout(Orientation::Vertical, Alignment::Fill, 10));
+    m_list = new List(this);
     set_items(items, items_short);
 }
 
 void ComboBox::set_selected_index(int idx) {
     if (m_items_short.empty())
         return;
-    const std::vector<Widget *> &children = m_container->children();
-    ((Button *) children[m_selected_index])->set_pushed(false);
-    ((Button *) children[idx])->set_pushed(true);
     m_selected_index = idx;
     set_caption(m_items_short[idx]);
 }
@@ -47,35 +298,71 @@ void ComboBox::set_items(const std::vector<std::string> &items, const std::vecto
 
     if (m_selected_index < 0 || m_selected_index >= (int) items.size())
         m_selected_index = 0;
-    while (m_container->child_count() != 0)
-        m_container->remove_child(m_container->child_count()-1);
-
-    if (m_scroll == nullptr && items.size() > 8) {
-        m_scroll = new VScrollPanel(m_popup);
-        m_scroll->set_fixed_height(300);
-        m_container = new Widget(m_scroll);
-        m_popup->set_layout(new BoxLayout(Orientation::Horizontal, Alignment::Middle));
-    }
-
-    m_container->set_layout(new GroupLayout(10));
-
-    int index = 0;
-    for (const auto &str: items) {
-        Button *button = new Button(m_container, str);
-        button->set_flags(Button::RadioButton);
-        button->set_callback([&, index] {
-            m_selected_index = index;
-            set_caption(m_items_short[index]);
-            set_pushed(false);
-            popup()->set_visible(false);
-            if (m_callback)
-                m_callback(index);
-        });
-        index++;
-    }
+
+    /* Build the index used by the filter */
+    std::vector<std::string> keys(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+        keys[i] = to_lower(items[i]);
+    m_sorted.resize(items.size());
+    std::iota(m_sorted.begin(), m_sorted.end(), 0);
+    std::stable_sort(m_sorted.begin(), m_sorted.end(),
+                     [&](int a, int b) { return keys[a] < keys[b]; });
+    m_keys.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+        m_keys[i] = std::move(keys[m_sorted[i]]);
+
+    m_filter.clear();
+    m_match_begin = 0;
+    m_match_end = items.size();
+
     set_selected_index(m_selected_index);
 }
 
+void ComboBox::set_filter(const std::string &filter) {
+    std::string key = to_lower(filter), prev = to_lower(m_filter);
+
+    /* Extending the filter can only narrow down the current matches */
+    if (key.compare(0, prev.size(), prev) != 0) {
+        m_match_begin = 0;
+        m_match_end = m_keys.size();
+    }
+    m_filter = filter;
+    if (key.empty()) {
+        m_match_begin = 0;
+        m_match_end = m_keys.size();
+        return;
+    }
+
+    auto begin = m_keys.begin() + m_match_begin,
+         end = m_keys.begin() + m_match_end;
+    begin = std::lower_bound(begin, end, key,
+        [](const std::string &item, const std::string &key) {
+            return item.compare(0, key.size(), key) < 0;
+        });
+    end = std::upper_bound(begin, end, key,
+        [](const std::string &key, const std::string &item) {
+            return item.compare(0, key.size(), key) > 0;
+        });
+    m_match_begin = (size_t) (begin - m_keys.begin());
+    m_match_end = (size_t) (end - m_keys.begin());
+}
+
+void ComboBox::choose(int index) {
+    set_selected_index(index);
+    set_pushed(false);
+    popup()->set_visible(false);
+    if (m_callback)
+        m_callback(index);
+}
+
+bool ComboBox::mouse_button_event(const Vector2i &p, int button, bool down, int modifiers) {
+    bool pushed = m_pushed;
+    bool result = PopupButton::mouse_button_event(p, button, down, modifiers);
+    if (m_pushed && !pushed)
+        m_list->open();
+    return result;
+}
+
 bool ComboBox::scroll_event(const Vector2i &p, const Vector2f &rel) {
     set_pushed(false);
     popup()->set_visible(false);
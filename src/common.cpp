@@ -18,6 +18,10 @@
 #endif
 
 #include <nanogui/opengl.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/mpscqueue.h>
+#include <nanogui/threadpool.h>
+#include <nanogui/arena.h>
 #include <map>
 #include <thread>
 #include <chrono>
@@ -66,6 +70,33 @@ void init() {
 }
 
 static bool mainloop_active = false;
+static bool mainloop_render_threads = false;
+static MPSCQueue<std::function<void()>> async_queue;
+static std::atomic<bool> async_pending { false };
+
+/// Run the functions submitted via async_ui() (main thread only)
+static void process_async_functions() {
+    if (!async_pending.exchange(false))
+        return;
+
+    std::vector<std::unique_lock<std::recursive_mutex>> guards;
+    for (auto kv : __nanogui_screens)
+        guards.emplace_back(kv.second->ui_mutex());
+
+    std::function<void()> func;
+    while (async_queue.pop(func)) {
+        try {
+            func();
+        } catch (const std::exception &e) {
+            std::cerr << "Caught exception in function submitted via async_ui(): "
+                      << e.what() << std::endl;
+        }
+    }
+    guards.clear();
+
+    for (auto kv : __nanogui_screens)
+        kv.second->redraw();
+}
 
 #if defined(EMSCRIPTEN)
 static size_t emscripten_last = 0;
@@ -88,6 +119,8 @@ void mainloop(int refresh) {
             }
         #endif
 
+        process_async_functions();
+
         for (auto kv : __nanogui_screens) {
             Screen *screen = kv.second;
             if (!screen->visible()) {
@@ -99,6 +132,9 @@ void mainloop(int refresh) {
             #if defined(EMSCRIPTEN)
                 if (emscripten_redraw || screen->tooltip_fade_in_progress())
                     screen->redraw();
+            #else
+                if (mainloop_render_threads && !screen->threaded_rendering())
+                    screen->set_threaded_rendering(true);
             #endif
             screen->draw_all();
             num_screens++;
@@ -173,6 +209,12 @@ void mainloop(int refresh) {
         leave();
     }
 
+    /* Return the OpenGL contexts to the main thread */
+    if (mainloop_render_threads) {
+        for (auto kv : __nanogui_screens)
+            kv.second->set_threaded_rendering(false);
+    }
+
     refresh_thread.join();
 }
 
@@ -184,7 +226,26 @@ bool active() {
     return mainloop_active;
 }
 
+void set_render_threads(bool value) {
+    mainloop_render_threads = value;
+}
+
+bool render_threads() {
+    return mainloop_render_threads;
+}
+
+void async_ui(const std::function<void()> &func) {
+    async_queue.push(func);
+    /* Only the first function submitted per iteration wakes up the main loop */
+    if (!async_pending.exchange(true)) {
+        #if !defined(EMSCRIPTEN)
+            glfwPostEmptyEvent();
+        #endif
+    }
+}
+
 void shutdown() {
+    ThreadPool::release();
     glfwTerminate();
 }
 
@@ -218,20 +279,12 @@ std::array<char, 8> utf8(int c) {
 }
 
 int __nanogui_get_image(NVGcontext *ctx, const std::string &name, uint8_t *data, uint32_t size) {
-    static std::map<std::string, int> icon_cache;
-    auto it = icon_cache.find(name);
-    if (it != icon_cache.end())
-        return it->second;
-    int icon_id = nvgCreateImageMem(ctx, 0, data, size);
-    if (icon_id == 0)
-        throw std::runtime_error("Unable to load resource data.");
-    icon_cache[name] = icon_id;
-    return icon_id;
+    /* The caller keeps the handle, so the image must not be evicted */
+    return ImageCache::get(ctx)->load_mem(name, data, size, 0, false);
 }
 
-std::vector<std::pair<int, std::string>>
-load_image_directory(NVGcontext *ctx, const std::string &path) {
-    std::vector<std::pair<int, std::string> > result;
+std::vector<std::string> __nanogui_list_images(const std::string &path) {
+    std::vector<std::string> result;
 #if !defined(_WIN32)
     DIR *dp = opendir(path.c_str());
     if (!dp)
@@ -250,12 +303,7 @@ load_image_directory(NVGcontext *ctx, const std::string &path) {
 #endif
         if (strstr(fname, "png") == nullptr)
             continue;
-        std::string full_name = path + "/" + std::string(fname);
-        int img = nvgCreateImage(ctx, full_name.c_str(), 0);
-        if (img == 0)
-            throw std::runtime_error("Could not open image data!");
-        result.push_back(
-            std::make_pair(img, full_name.substr(0, full_name.length() - 4)));
+        result.push_back(path + "/" + std::string(fname));
 #if !defined(_WIN32)
     }
     closedir(dp);
@@ -266,6 +314,19 @@ load_image_directory(NVGcontext *ctx, const std::string &path) {
     return result;
 }
 
+std::vector<std::pair<int, std::string>>
+load_image_directory(NVGcontext *ctx, const std::string &path) {
+    std::vector<std::pair<int, std::string> > result;
+    ImageCache *cache = ImageCache::get(ctx);
+    for (const std::string &full_name : __nanogui_list_images(path)) {
+        /* Callers keep the handles: never evict them */
+        int img = cache->load_file(full_name, 0, false);
+        result.push_back(
+            std::make_pair(img, full_name.substr(0, full_name.length() - 4)));
+    }
+    return result;
+}
+
 std::string file_dialog(const std::vector<std::pair<std::string, std::string>> &filetypes, bool save) {
     auto result = file_dialog(filetypes, save, false);
     return result.empty() ? "" : result.front();
@@ -404,5 +465,29 @@ void Object::dec_ref(bool dealloc) const noexcept {
 
 Object::~Object() { }
 
+void *Object::operator new(size_t size) {
+    Arena *arena = Arena::current();
+    /* Larger objects are rare: they always come from the heap */
+    if (!arena || size > Arena::max_block_size)
+        return ::operator new(size);
+    void *ptr = arena->allocate(size);
+    arena->inc_ref();
+    return ptr;
+}
+
+void Object::operator delete(void *ptr, size_t size) noexcept {
+    if (!ptr)
+        return;
+    /* The arena is identified by the slab containing the object, hence
+       objects do not need to record where they came from */
+    Arena *arena = Arena::owner(ptr);
+    if (arena) {
+        arena->deallocate(ptr, size);
+        arena->dec_ref();
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
 NAMESPACE_END(nanogui)
 
@@ -26,6 +26,7 @@
 #include <nanogui/entypo.h>
 #include <nanogui/messagedialog.h>
 #include <nanogui/textbox.h>
+#include <nanogui/textarea.h>
 #include <nanogui/slider.h>
 #include <nanogui/imagepanel.h>
 #include <nanogui/imageview.h>
@@ -379,6 +380,21 @@ public:
             func[i] = 0.5f * (0.5f * std::sin(i / 10.f) +
                               0.5f * std::cos(i / 23.f) + 1);
 
+        layer = tab_widget->create_tab("Text Area");
+        layer->set_layout(new GroupLayout());
+        layer->add<Label>("Multi-line text editor", "sans-bold");
+
+        TextArea *text_area = layer->add<TextArea>();
+        text_area->set_fixed_size(Vector2i(240, 140));
+        std::string text;
+        for (int i = 1; i <= 1000; ++i)
+            text += "Line " + std::to_string(i) + " of a longer document\n";
+        text_area->set_value(text);
+        text_area->set_callback([text_area] {
+            std::cout << "Text area now has " << text_area->line_count()
+                      << " lines" << std::endl;
+        });
+
         // Dummy tab used to represent the last tab button.
         tab_widget->create_tab("+");
 
@@ -0,0 +1,741 @@
+/*
+    src/example_tests.cpp -- Self-checks and timings of the containers and
+    widgets that NanoGUI relies on for performance (run by 'ctest', or
+    directly with the names of the tests to run as arguments)
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/arena.h>
+#include <nanogui/combobox.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/mpscqueue.h>
+#include <nanogui/opengl.h>
+#include <nanogui/textarea.h>
+#include <nanogui/theme.h>
+#include <nanogui/threadpool.h>
+#include <nanogui/vec_types.h>
+#include <nanogui/window.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace nanogui;
+
+static int failures = 0;
+
+static void check(bool cond, const char *expr, const char *file, int line) {
+    if (cond)
+        return;
+    std::cerr << file << ":" << line << ": check failed: " << expr << std::endl;
+    failures++;
+}
+
+#define CHECK(cond) check(cond, #cond, __FILE__, __LINE__)
+
+/// Run \c func \c iterations times and print the average time per call
+template <typename Func> static void benchmark(const char *name, size_t iterations, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+        func(i);
+    double elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << name << ": " << elapsed / iterations << " ns" << std::endl;
+}
+
+/* ------------------------------- MPSCQueue ------------------------------- */
+
+static void test_mpsc_queue() {
+    const size_t producers = 4, count = 100000;
+    MPSCQueue<size_t> queue;
+
+    size_t value = 0;
+    CHECK(!queue.pop(value));
+    queue.push(1);
+    queue.push(2);
+    CHECK(queue.pop(value) && value == 1);
+    CHECK(queue.pop(value) && value == 2);
+    CHECK(!queue.pop(value));
+
+    /* Every producer pushes increasing values tagged with its index, which
+       the consumer must receive in order and exactly once */
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p)
+        threads.emplace_back([&queue, p, count] {
+            for (size_t i = 0; i < count; ++i)
+                queue.push(i * producers + p);
+        });
+
+    std::vector<size_t> next(producers, 0);
+    size_t received = 0, out_of_order = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (received < producers * count) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        size_t p = value % producers, i = value / producers;
+        if (i != next[p])
+            out_of_order++;
+        next[p] = i + 1;
+        received++;
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(out_of_order == 0);
+    CHECK(!queue.pop(value));
+    std::cout << "  push/pop with " << producers << " producers: "
+              << elapsed / (producers * count) << " ns" << std::endl;
+
+    benchmark("push/pop (single thread)", 1000000, [&](size_t i) {
+        queue.push(i);
+        queue.pop(value);
+    });
+}
+
+/* ------------------------------- ThreadPool ------------------------------ */
+
+static void test_thread_pool() {
+    ref<ThreadPool> pool = new ThreadPool(4);
+    CHECK(pool->thread_count() == 4);
+
+    /* Futures */
+    std::vector<std::future<size_t>> futures;
+    for (size_t i = 0; i < 1000; ++i)
+        futures.push_back(pool->submit([i] { return i * i; }));
+    bool results_ok = true;
+    for (size_t i = 0; i < futures.size(); ++i)
+        results_ok &= futures[i].get() == i * i;
+    CHECK(results_ok);
+
+    /* Exceptions are passed on to the future */
+    auto failing = pool->submit([]() -> int { throw std::runtime_error("expected"); });
+    bool thrown = false;
+    try {
+        failing.get();
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    /* Every index is visited exactly once, also when nested in tasks */
+    const size_t size = 1000000;
+    std::vector<std::atomic<uint8_t>> visits(size);
+    pool->parallel_for(0, size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            visits[i]++;
+    });
+    auto nested = pool->submit([&] {
+        pool->parallel_for(0, size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                visits[i]++;
+        }, 1000);
+    });
+    nested.get();
+    size_t wrong = 0;
+    for (auto &v : visits)
+        wrong += v != 2;
+    CHECK(wrong == 0);
+
+    thrown = false;
+    try {
+        pool->parallel_for(0, 100, [](size_t begin, size_t) {
+            if (begin == 0)
+                throw std::runtime_error("expected");
+        }, 10);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    benchmark("submit + get", 10000, [&](size_t i) {
+        pool->submit([i] { return i; }).get();
+    });
+    std::atomic<size_t> sum { 0 };
+    benchmark("parallel_for (1M indices)", 100, [&](size_t) {
+        pool->parallel_for(0, size, [&](size_t begin, size_t end) {
+            size_t s = 0;
+            for (size_t i = begin; i < end; ++i)
+                s += i;
+            sum += s;
+        });
+    });
+    CHECK(sum == 100 * (size * (size - 1) / 2));
+
+    /* Helpers of parallel_for() may still be queued (they return right away) */
+    for (int i = 0; i < 1000 && pool->pending() > 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK(pool->pending() == 0);
+}
+
+/* --------------------------------- Arena --------------------------------- */
+
+namespace {
+struct SmallObject : Object { uint64_t payload[4]; };
+struct LargeObject : Object { uint8_t payload[Arena::max_block_size * 2]; };
+}
+
+static void test_arena() {
+    ref<Object> heap_object = new SmallObject();
+    CHECK(Arena::owner(heap_object.get()) == nullptr);
+
+    ref<Arena> arena = new Arena();
+    std::vector<ref<Object>> objects;
+    {
+        Arena::Scope scope(arena);
+        CHECK(Arena::current() == arena.get());
+        for (int i = 0; i < 10000; ++i)
+            objects.push_back(new SmallObject());
+        objects.push_back(new LargeObject());
+    }
+    CHECK(Arena::current() == nullptr);
+
+    /* Objects find their arena by address, except large ones (heap) */
+    bool owners_ok = true;
+    for (size_t i = 0; i + 1 < objects.size(); ++i)
+        owners_ok &= Arena::owner(objects[i].get()) == arena.get();
+    CHECK(owners_ok);
+    CHECK(Arena::owner(objects.back().get()) == nullptr);
+    CHECK(arena->allocated() >= 10000 * sizeof(SmallObject));
+    CHECK(arena->reserved() >= arena->allocated());
+
+    /* Released blocks are recycled */
+    size_t reserved = arena->reserved();
+    objects.resize(5000);
+    {
+        Arena::Scope scope(arena);
+        for (int i = 0; i < 5000; ++i)
+            objects.push_back(new SmallObject());
+    }
+    CHECK(arena->reserved() == reserved);
+
+    /* Nested scopes */
+    ref<Arena> inner = new Arena();
+    {
+        Arena::Scope scope(arena);
+        {
+            Arena::Scope scope2(inner);
+            objects.push_back(new SmallObject());
+        }
+        objects.push_back(new SmallObject());
+    }
+    CHECK(Arena::owner(objects[objects.size() - 2].get()) == inner.get());
+    CHECK(Arena::owner(objects.back().get()) == arena.get());
+
+    /* The arena outlives its objects, and its slabs are unregistered */
+    Object *address = objects[0].get();
+    arena = nullptr;
+    inner = nullptr;
+    objects.clear();
+    CHECK(Arena::owner(address) == nullptr);
+
+    benchmark("new + release (heap)", 1000000, [](size_t) {
+        ref<Object> object = new SmallObject();
+    });
+    arena = new Arena();
+    Arena::Scope scope(arena);
+    benchmark("new + release (arena)", 1000000, [](size_t) {
+        ref<Object> object = new SmallObject();
+    });
+}
+
+/* ------------------------- NanoVG without OpenGL ------------------------- */
+
+/* A NanoVG renderer that draws nothing and only keeps track of the texture
+   sizes, so that widgets and the image cache can be checked without a
+   window or an OpenGL context */
+namespace {
+struct NullRenderer {
+    std::map<int, Vector2i> textures;
+    int next_texture = 1;
+};
+}
+
+static int null_create(void *) { return 1; }
+
+static int null_create_texture(void *uptr, int, int w, int h, int, const unsigned char *) {
+    NullRenderer *renderer = (NullRenderer *) uptr;
+    int image = renderer->next_texture++;
+    renderer->textures[image] = Vector2i(w, h);
+    return image;
+}
+
+static int null_delete_texture(void *uptr, int image) {
+    return ((NullRenderer *) uptr)->textures.erase(image) ? 1 : 0;
+}
+
+static int null_update_texture(void *uptr, int image, int, int, int, int,
+                               const unsigned char *) {
+    return ((NullRenderer *) uptr)->textures.count(image) ? 1 : 0;
+}
+
+static int null_texture_size(void *uptr, int image, int *w, int *h) {
+    NullRenderer *renderer = (NullRenderer *) uptr;
+    auto it = renderer->textures.find(image);
+    if (it == renderer->textures.end())
+        return 0;
+    *w = it->second.x();
+    *h = it->second.y();
+    return 1;
+}
+
+/* The argument lists of the remaining callbacks differ between NanoVG
+   versions, hence they are deduced from the callback types */
+template <typename... Args> static void null_render(void *, Args...) { }
+
+static NVGcontext *create_null_context(NullRenderer *renderer) {
+    NVGparams params;
+    memset(&params, 0, sizeof(NVGparams));
+    params.userPtr = renderer;
+    params.edgeAntiAlias = 1;
+    params.renderCreate = null_create;
+    params.renderCreateTexture = null_create_texture;
+    params.renderDeleteTexture = null_delete_texture;
+    params.renderUpdateTexture = null_update_texture;
+    params.renderGetTextureSize = null_texture_size;
+    params.renderViewport = null_render;
+    params.renderCancel = null_render;
+    params.renderFlush = null_render;
+    params.renderFill = null_render;
+    params.renderStroke = null_render;
+    params.renderTriangles = null_render;
+    params.renderDelete = null_render;
+    NVGcontext *ctx = nvgCreateInternal(&params);
+    if (!ctx)
+        throw std::runtime_error("Could not create a NanoVG context!");
+    return ctx;
+}
+
+/* ------------------------------ ImageCache ------------------------------- */
+
+/// Encode an uncompressed 24-bit BMP image
+static std::vector<uint8_t> bmp_image(int w, int h) {
+    size_t row = ((size_t) w * 3 + 3) & ~(size_t) 3, size = 54 + row * h;
+    std::vector<uint8_t> data(size, 0);
+    auto put = [&data](size_t offset, uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            data[offset + i] = (uint8_t) (value >> (8 * i));
+    };
+    data[0] = 'B'; data[1] = 'M';
+    put(2, (uint32_t) size, 4);
+    put(10, 54, 4);                     // Offset of the pixels
+    put(14, 40, 4);                     // Size of the info header
+    put(18, (uint32_t) w, 4);
+    put(22, (uint32_t) h, 4);
+    put(26, 1, 2);                      // Planes
+    put(28, 24, 2);                     // Bits per pixel
+    put(34, (uint32_t) (row * h), 4);
+    return data;
+}
+
+static void test_image_cache() {
+    NullRenderer renderer;
+    NVGcontext *ctx = create_null_context(&renderer);
+    ImageCache *cache = ImageCache::get(ctx);
+
+    const size_t image_bytes = 64 * 64 * 4;
+    std::vector<uint8_t> bmp = bmp_image(64, 64);
+    auto load = [&](const std::string &key, bool evictable = true) {
+        return cache->load_mem(key, bmp.data(), bmp.size(), 0, evictable);
+    };
+
+    cache->set_budget(4 * image_bytes);
+    int pinned = load("pinned", false);
+    int a = load("a"), b = load("b"), c = load("c");
+    CHECK(pinned != 0 && a != 0 && b != 0 && c != 0);
+    CHECK(load("a") == a);
+    CHECK(cache->size() == 4);
+    CHECK(cache->memory_usage() == 4 * image_bytes);
+
+    /* Images used in the current or the previous frame are never evicted */
+    int d = load("d");
+    CHECK(d != 0 && cache->size() == 5 && cache->evictions() == 0);
+    cache->next_frame();
+    CHECK(cache->size() == 5 && cache->evictions() == 0);
+
+    /* Then the least recently used evictable image goes first ("a" was
+       loaded again after "b") */
+    cache->touch(a);
+    cache->next_frame();
+    CHECK(cache->evictions() == 1);
+    CHECK(cache->memory_usage() == 4 * image_bytes);
+    CHECK(cache->find("b") == 0);
+    CHECK(renderer.textures.count(b) == 0);
+
+    /* Touching an evicted image brings it back under a new handle */
+    int b2 = cache->touch(b);
+    CHECK(b2 != 0 && b2 != b);
+    CHECK(cache->find("b") == b2);
+    int w = 0, h = 0;
+    nvgImageSize(ctx, b2, &w, &h);
+    CHECK(w == 64 && h == 64);
+    CHECK(cache->touch(b2) == b2);
+    CHECK(cache->touch(12345) == 12345);
+
+    /* "c" is now the least recently used evictable image */
+    CHECK(cache->evictions() == 2);
+    CHECK(cache->find("c") == 0);
+
+    /* Shrinking the budget evicts everything except the pinned image once
+       the images are no longer in use */
+    cache->set_budget(0);
+    cache->next_frame();
+    cache->next_frame();
+    CHECK(cache->size() == 1);
+    CHECK(cache->find("pinned") == pinned);
+    CHECK(cache->memory_usage() == image_bytes);
+
+    /* Invalidated images are reloaded from their source */
+    cache->invalidate("pinned");
+    CHECK(cache->size() == 0);
+    CHECK(load("pinned", false) != 0);
+
+    cache->set_budget(1024 * image_bytes);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back("image " + std::to_string(i));
+        load(keys.back());
+    }
+    benchmark("find (1000 images)", 1000000, [&](size_t i) {
+        cache->find(keys[i % keys.size()]);
+    });
+    benchmark("next_frame (1000 images)", 10000, [&](size_t) {
+        cache->next_frame();
+    });
+
+    ImageCache::release(ctx);
+    CHECK(renderer.textures.size() == 1); // Only the glyph atlas remains
+    nvgDeleteInternal(ctx);
+}
+
+/* ------------------------------- TextArea -------------------------------- */
+
+namespace {
+/// Exposes the gap buffer operations of TextArea
+struct TestTextArea : TextArea {
+    using TextArea::TextArea;
+    using TextArea::erase_text;
+    using TextArea::line_of;
+    using TextArea::line_start;
+};
+}
+
+/// Compare the text and the line index of a TextArea with a string
+static bool same_text(const TestTextArea *area, const std::string &text, std::mt19937 &rng) {
+    if (area->value() != text || area->size() != text.size())
+        return false;
+    size_t lines = (size_t) std::count(text.begin(), text.end(), '\n') + 1;
+    if (area->line_count() != lines)
+        return false;
+
+    std::vector<size_t> starts(1, 0);
+    for (size_t i = 0; i < text.size(); ++i)
+        if (text[i] == '\n')
+            starts.push_back(i + 1);
+    for (size_t line = 0; line < lines; ++line) {
+        if (area->line_start(line) != starts[line])
+            return false;
+        size_t end = line + 1 < lines ? starts[line + 1] - 1 : text.size();
+        if (area->line(line) != text.substr(starts[line], end - starts[line]))
+            return false;
+    }
+    for (int i = 0; i < 10; ++i) {
+        size_t pos = rng() % (text.size() + 1);
+        size_t line = (size_t) std::count(text.begin(), text.begin() + pos, '\n');
+        if (area->line_of(pos) != line)
+            return false;
+    }
+    return true;
+}
+
+static void test_text_area() {
+    ref<TestTextArea> area = new TestTextArea(nullptr);
+    CHECK(area->value().empty() && area->line_count() == 1);
+
+    area->set_value("first\nsecond\n\nfourth");
+    CHECK(area->line_count() == 4);
+    CHECK(area->line(1) == "second" && area->line(2).empty() && area->line(3) == "fourth");
+    CHECK(area->line(4).empty());
+
+    area->set_cursor_pos(5);
+    area->insert(" line\nnew");
+    CHECK(area->value() == "first line\nnew\nsecond\n\nfourth");
+    CHECK(area->cursor_pos() == 14);
+    area->append("\nfifth");
+    CHECK(area->line_count() == 6 && area->line(5) == "fifth");
+    area->erase_text(0, 11);
+    CHECK(area->value() == "new\nsecond\n\nfourth\nfifth");
+
+    /* UTF-8 sequences are never split by the cursor */
+    area->set_value("a\xc3\xa4" "b");
+    area->set_cursor_pos(2);
+    CHECK(area->cursor_pos() == 1);
+
+    /* Random edits compared with a plain string (the gap buffers are moved
+       back and forth and reallocated many times) */
+    std::mt19937 rng(1);
+    std::string text;
+    area->set_value(text);
+    const char alphabet[] = "abc \n";
+    bool same = true;
+    for (int step = 0; step < 2000 && same; ++step) {
+        size_t pos = rng() % (text.size() + 1);
+        if (rng() % 3 != 0 || text.empty()) {
+            std::string insertion;
+            size_t length = rng() % (step % 100 == 0 ? 2000 : 20);
+            for (size_t i = 0; i < length; ++i)
+                insertion += alphabet[rng() % (sizeof(alphabet) - 1)];
+            area->set_cursor_pos(pos);
+            area->insert(insertion);
+            text.insert(pos, insertion);
+        } else {
+            size_t end = std::min(text.size(), pos + rng() % 50);
+            area->erase_text(pos, end);
+            text.erase(pos, end - pos);
+        }
+        same = same_text(area, text, rng);
+    }
+    CHECK(same);
+
+    /* Typing in the middle of a large document only moves the gap */
+    std::string document;
+    for (int i = 0; i < 100000; ++i)
+        document += "Line " + std::to_string(i) + " of a large document\n";
+    area->set_value(document);
+    CHECK(area->line_count() == 100001);
+    area->set_cursor_pos(document.size() / 2);
+    benchmark("insert a character (100k lines)", 100000, [&](size_t) {
+        area->insert("x");
+    });
+    benchmark("line_of (100k lines)", 1000000, [&](size_t i) {
+        area->line_of((i * 7919) % area->size());
+    });
+    benchmark("append a line (100k lines)", 100000, [&](size_t) {
+        area->append("log output\n");
+    });
+    CHECK(area->line_count() == 200001);
+}
+
+/* -------------------------------- ComboBox ------------------------------- */
+
+namespace {
+/// Exposes the rows shown by the popup of a ComboBox
+struct TestComboBox : ComboBox {
+    using ComboBox::ComboBox;
+    using ComboBox::row_item;
+};
+}
+
+static std::string lower(std::string s) {
+    for (char &c : s)
+        c = (char) std::tolower((unsigned char) c);
+    return s;
+}
+
+/// Check the rows shown for the current filter against a linear search
+static bool same_matches(const TestComboBox *combo) {
+    const std::vector<std::string> &items = combo->items();
+    std::string prefix = lower(combo->filter());
+    std::vector<int> expected;
+    for (size_t i = 0; i < items.size(); ++i)
+        if (lower(items[i]).compare(0, prefix.size(), prefix) == 0)
+            expected.push_back((int) i);
+    if (combo->match_count() != expected.size())
+        return false;
+
+    std::vector<int> rows;
+    for (size_t row = 0; row < combo->match_count(); ++row)
+        rows.push_back(combo->row_item(row));
+    /* Without a filter, rows are shown in the order of the items */
+    if (prefix.empty())
+        return rows == expected;
+    /* Otherwise they are sorted alphabetically (ignoring case) */
+    for (size_t row = 1; row < rows.size(); ++row)
+        if (lower(items[rows[row]]) < lower(items[rows[row - 1]]))
+            return false;
+    std::sort(rows.begin(), rows.end());
+    return rows == expected;
+}
+
+static void test_combo_box() {
+    NullRenderer renderer;
+    NVGcontext *ctx = create_null_context(&renderer);
+    {
+        ref<Widget> root = new Widget(nullptr);
+        root->set_theme(new Theme(ctx));
+        Window *window = new Window(root, "ComboBox");
+
+        std::vector<std::string> items;
+        const char *words[] = { "Alpha", "alpine", "Beta", "bet", "Gamma", "gam", "delta" };
+        for (int i = 0; i < 20000; ++i)
+            items.push_back(std::string(words[i % 7]) + " " + std::to_string(i));
+        items.push_back("");
+        items.push_back("ALPHA");
+
+        TestComboBox *combo = new TestComboBox(window, items);
+        CHECK(combo->searchable());
+        CHECK(same_matches(combo));
+
+        /* Typing narrows down the matches, backspace widens them again */
+        bool same = true;
+        for (const char *filter : { "a", "al", "alp", "alph", "alpha", "alpha ",
+                                    "alpha 1", "alpha 19", "alpha 1", "al", "",
+                                    "GAM", "gamma 2", "x", "bet 3", "ALPHA" }) {
+            combo->set_filter(filter);
+            same &= same_matches(combo);
+        }
+        CHECK(same);
+        combo->set_filter("alpha");
+        CHECK(combo->match_count() == 20000 / 7 + 1 + 1);
+
+        combo->set_items({ "one", "two", "three" });
+        CHECK(combo->filter().empty() && combo->match_count() == 3);
+        CHECK(!combo->searchable());
+        combo->set_filter("t");
+        CHECK(combo->match_count() == 2 && same_matches(combo));
+
+        combo->set_items(items);
+        const char *keystrokes[] = { "g", "ga", "gam", "gamm", "gamma", "gamma ",
+                                     "gamma 1", "gamma 12" };
+        benchmark("set_filter (20k items, per keystroke)", 100000, [&](size_t i) {
+            combo->set_filter(keystrokes[i % 8]);
+        });
+        benchmark("set_items (20k items)", 20, [&](size_t) {
+            combo->set_items(items);
+        });
+    }
+    nvgDeleteInternal(ctx);
+}
+
+/* --------------------------------- Array --------------------------------- */
+
+static void test_array() {
+#if defined(NANOGUI_USE_ENOKI)
+    std::cout << "  (skipped: vector types are provided by Enoki)" << std::endl;
+#else
+    /* Constant evaluation uses the scalar code path */
+    constexpr Vector4f c = Vector4f(1.f, 2.f, 3.f, 4.f) * Vector4f(2.f) + Vector4f(1.f);
+    static_assert(c.x() == 3.f && c.w() == 9.f, "constexpr arithmetic");
+    static_assert(hsum(Vector3i(1, 2, 3)) == 6, "constexpr reduction");
+
+    Vector4f a(1.f, -2.f, 3.f, -4.f), b(4.f, 3.f, 2.f, 1.f);
+    CHECK(a + b == Vector4f(5.f, 1.f, 5.f, -3.f));
+    CHECK(a - b == Vector4f(-3.f, -5.f, 1.f, -5.f));
+    CHECK(a * b == Vector4f(4.f, -6.f, 6.f, -4.f));
+    CHECK(b / Vector4f(2.f) == Vector4f(2.f, 1.5f, 1.f, 0.5f));
+    CHECK(min(a, b) == Vector4f(1.f, -2.f, 2.f, -4.f));
+    CHECK(max(a, b) == Vector4f(4.f, 3.f, 3.f, 1.f));
+    CHECK(-a == Vector4f(-1.f, 2.f, -3.f, 4.f));
+    CHECK(abs(a) == Vector4f(1.f, 2.f, 3.f, 4.f));
+    CHECK(dot(a, b) == 0.f);
+    CHECK(hsum(a) == -2.f && hprod(a) == 24.f && hmin(a) == -4.f && hmax(a) == 3.f);
+    CHECK(std::abs(norm(normalize(a)) - 1.f) < 1e-6f);
+    CHECK(clamp(a, Vector4f(-1.f), Vector4f(1.f)) == Vector4f(1.f, -1.f, 1.f, -1.f));
+    CHECK(floor(Vector2f(1.5f, -1.5f)) == Vector2f(1.f, -2.f));
+    CHECK(ceil(Vector2f(1.5f, -1.5f)) == Vector2f(2.f, -1.f));
+    CHECK(round(Vector2f(1.4f, -1.6f)) == Vector2f(1.f, -2.f));
+    CHECK((!detail::use_simd<float, 4> || alignof(Vector4f) == 16));
+
+    Vector4f d = a;
+    d += b;
+    d *= Vector4f(2.f);
+    d -= b;
+    d /= Vector4f(1.f, 1.f, 1.f, 2.f);
+    CHECK(d == Vector4f(6.f, -1.f, 8.f, -3.5f));
+
+    /* Masks */
+    CHECK(all(a < Vector4f(5.f)) && !any(a > Vector4f(5.f)) && none(a > Vector4f(5.f)));
+    CHECK(any(eq(a, b)) == false && all(neq(a, b)));
+    CHECK(select(a < b, a, b) == min(a, b));
+    CHECK(!(a != a) && a != b);
+
+    /* Integer vectors and conversions */
+    Vector2i p(3, 4), q(1, 2);
+    CHECK(p + q == Vector2i(4, 6) && p * q == Vector2i(3, 8));
+    CHECK(squared_norm(p) == 25);
+    CHECK(Vector2f(p) == Vector2f(3.f, 4.f));
+    CHECK(Vector2i(Vector2f(2.7f, -1.2f)) == Vector2i(2, -1));
+    CHECK(cross(Vector3f(1.f, 0.f, 0.f), Vector3f(0.f, 1.f, 0.f)) == Vector3f(0.f, 0.f, 1.f));
+
+    /* The SIMD and the scalar code paths agree */
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> dist(-100.f, 100.f);
+    bool same = true;
+    for (int i = 0; i < 10000; ++i) {
+        Vector4f x(dist(rng), dist(rng), dist(rng), dist(rng)),
+                 y(dist(rng), dist(rng), dist(rng), dist(rng));
+        Vector4f sum = x + y, product = x * y, lo = min(x, y);
+        for (size_t k = 0; k < 4; ++k)
+            same &= sum[k] == x[k] + y[k] && product[k] == x[k] * y[k] &&
+                    lo[k] == std::min(x[k], y[k]);
+    }
+    CHECK(same);
+
+    std::vector<Vector4f> values(4096, Vector4f(1.f, 2.f, 3.f, 4.f));
+    Vector4f accum;
+    benchmark("Vector4f multiply-add", 10000000, [&](size_t i) {
+        accum = accum * Vector4f(0.5f) + values[i & 4095];
+    });
+    CHECK(accum.x() > 0.f);
+#endif
+}
+
+int main(int argc, char **argv) {
+    struct Test {
+        const char *name;
+        void (*func)();
+    };
+    const Test tests[] = {
+        { "mpsc_queue", test_mpsc_queue },
+        { "thread_pool", test_thread_pool },
+        { "arena", test_arena },
+        { "image_cache", test_image_cache },
+        { "text_area", test_text_area },
+        { "combo_box", test_combo_box },
+        { "array", test_array },
+    };
+
+    for (const Test &test : tests) {
+        /* Run the tests given on the command line (default: all) */
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i)
+            selected |= strcmp(argv[i], test.name) == 0;
+        if (!selected)
+            continue;
+
+        std::cout << test.name << std::endl;
+        int previous_failures = failures;
+        try {
+            test.func();
+        } catch (const std::exception &e) {
+            std::cerr << "Caught exception in " << test.name << ": " << e.what() << std::endl;
+            failures++;
+        }
+        if (failures != previous_failures)
+            std::cout << "  FAILED" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -15,6 +15,16 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstdio>
+#include <algorithm>
+#include <thread>
+
+#if defined(_WIN32)
+#  include <process.h>
+#  define getpid _getpid
+#else
+#  include <unistd.h>
+#endif
 
 #if !defined(GL_RGBA8)
 #  define GL_RGBA8            0x8058
@@ -28,8 +38,143 @@
 
 NAMESPACE_BEGIN(nanogui)
 
-static GLuint create_shader_helper(GLint type, const std::string &name,
-                                  const std::string &defines,
+/// Directory used by the program binary cache (empty: disabled)
+static std::string program_binary_cache_dir;
+
+#if defined(NANOGUI_USE_OPENGL)
+/// Magic number at the beginning of program binary cache files ("NGPB")
+static const uint32_t program_binary_magic = 0x4250474E;
+
+static uint64_t fnv1a(uint64_t hash, const char *str) {
+    if (!str)
+        str = "";
+    do {
+        hash ^= (uint8_t) *str;
+        hash *= 0x100000001b3ull;
+    } while (*str++ != '\0'); /* Includes the terminator as a field separator */
+    return hash;
+}
+
+static bool program_binary_supported() {
+    while (glGetError() != GL_NO_ERROR)
+        ;
+    GLint n_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &n_formats);
+    return glGetError() == GL_NO_ERROR && n_formats > 0;
+}
+
+static std::string program_binary_filename(const std::string &defines,
+                                           const std::string &vertex_str,
+                                           const std::string &fragment_str,
+                                           const std::string &geometry_str) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hash = fnv1a(hash, (const char *) glGetString(GL_VENDOR));
+    hash = fnv1a(hash, (const char *) glGetString(GL_RENDERER));
+    hash = fnv1a(hash, (const char *) glGetString(GL_VERSION));
+    hash = fnv1a(hash, defines.c_str());
+    hash = fnv1a(hash, vertex_str.c_str());
+    hash = fnv1a(hash, fragment_str.c_str());
+    hash = fnv1a(hash, geometry_str.c_str());
+
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long) hash);
+    return program_binary_cache_dir + "/" + buf + ".glbin";
+}
+
+static GLuint load_program_binary(const std::string &filename) {
+    std::ifstream is(filename, std::ios::binary);
+    if (!is)
+        return 0;
+
+    uint32_t header[2];
+    if (!is.read((char *) header, sizeof(header)) || header[0] != program_binary_magic)
+        return 0;
+
+    std::vector<char> binary((std::istreambuf_iterator<char>(is)),
+                             std::istreambuf_iterator<char>());
+    if (binary.empty())
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum) header[1], binary.data(), (GLsizei) binary.size());
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        /* Stale binary (e.g. after a driver update): recompile from source */
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+static void save_program_binary(const std::string &filename, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary((size_t) length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    if (length <= 0)
+        return;
+
+    /* Write to a temporary file first so that concurrently starting
+       applications never observe a partially written binary. The name is
+       unique per process and thread, since several writers may store the
+       same entry at the same time */
+    std::string tmp_filename = filename + ".tmp" + std::to_string(getpid()) + "-" +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    std::ofstream os(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!os)
+        return;
+    uint32_t header[2] = { program_binary_magic, (uint32_t) format };
+    os.write((const char *) header, sizeof(header));
+    os.write(binary.data(), length);
+    os.close();
+
+    if (!os || std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        std::remove(tmp_filename.c_str());
+}
+#endif
+
+void GLShader::set_binary_cache_directory(const std::string &path) {
+    program_binary_cache_dir = path;
+    while (program_binary_cache_dir.size() > 1 &&
+           (program_binary_cache_dir.back() == '/' || program_binary_cache_dir.back() == '\\'))
+        program_binary_cache_dir.pop_back();
+}
+
+const std::string &GLShader::binary_cache_directory() {
+    return program_binary_cache_dir;
+}
+
+#if !defined(GL_COMPLETION_STATUS_KHR)
+#  define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+/// Was KHR/ARB_parallel_shader_compile detected? (checked once by \ref init_async)
+static int parallel_shader_compile = -1;
+
+static void enable_parallel_shader_compile() {
+    if (parallel_shader_compile != -1)
+        return;
+
+    typedef void (*max_threads_fn)(GLuint);
+    max_threads_fn max_threads = nullptr;
+    if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+        max_threads = (max_threads_fn) glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+    else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+        max_threads = (max_threads_fn) glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+
+    parallel_shader_compile = max_threads ? 1 : 0;
+    if (max_threads)
+        max_threads(0xFFFFFFFFu); /* Let the driver pick the number of threads */
+}
+
+static GLuint create_shader_helper(GLint type, const std::string &defines,
                                   std::string shader_string) {
     if (shader_string.empty())
         return (GLuint) 0;
@@ -50,11 +195,20 @@ static GLuint create_shader_helper(GLint type, const std::string &name,
         }
     }
 
+    /* Compilation status is only queried in check_shader_helper(), which
+       lets drivers with parallel compilation work in the background */
     GLuint id = glCreateShader(type);
     const char *shader_string_const = shader_string.c_str();
     glShaderSource(id, 1, &shader_string_const, nullptr);
     glCompileShader(id);
 
+    return id;
+}
+
+static void check_shader_helper(GLuint id, GLint type, const std::string &name) {
+    if (!id)
+        return;
+
     GLint status;
     glGetShaderiv(id, GL_COMPILE_STATUS, &status);
 
@@ -70,13 +224,19 @@ static GLuint create_shader_helper(GLint type, const std::string &name,
             std::cerr << "geometry shader";
 #endif
         std::cerr << " \"" << name << "\":" << std::endl;
-        std::cerr << shader_string << std::endl << std::endl;
+
+        GLint source_length = 0;
+        glGetShaderiv(id, GL_SHADER_SOURCE_LENGTH, &source_length);
+        if (source_length > 0) {
+            std::string source((size_t) source_length, '\0');
+            glGetShaderSource(id, source_length, nullptr, &source[0]);
+            std::cerr << source.c_str() << std::endl << std::endl;
+        }
+
         glGetShaderInfoLog(id, sizeof(buffer), nullptr, buffer);
         std::cerr << "Error: " << std::endl << buffer << std::endl;
         throw std::runtime_error("Shader compilation failed!");
     }
-
-    return id;
 }
 
 bool GLShader::init_from_files(
@@ -102,6 +262,17 @@ bool GLShader::init(const std::string &name,
                     const std::string &vertex_str,
                     const std::string &fragment_str,
                     const std::string &geometry_str) {
+    if (!init_async(name, vertex_str, fragment_str, geometry_str))
+        return false;
+    if (m_link_pending)
+        finish_link();
+    return true;
+}
+
+bool GLShader::init_async(const std::string &name,
+                          const std::string &vertex_str,
+                          const std::string &fragment_str,
+                          const std::string &geometry_str) {
     std::string defines;
     for (auto def : m_definitions)
         defines += std::string("#define ") + def.first + std::string(" ") + def.second + "\n";
@@ -110,17 +281,35 @@ bool GLShader::init(const std::string &name,
     glGenVertexArrays(1, &m_vertex_array_object);
 #endif
     m_name = name;
+    m_loaded_from_binary_cache = false;
+    m_link_pending = false;
+    m_binary_cache_filename.clear();
+
+#if defined(NANOGUI_USE_OPENGL)
+    if (!program_binary_cache_dir.empty() && program_binary_supported()) {
+        m_binary_cache_filename = program_binary_filename(
+            defines, vertex_str, fragment_str, geometry_str);
+        m_program_shader = load_program_binary(m_binary_cache_filename);
+        if (m_program_shader) {
+            m_loaded_from_binary_cache = true;
+            return true;
+        }
+    }
+#endif
+
+    enable_parallel_shader_compile();
+
     m_vertex_shader =
-        create_shader_helper(GL_VERTEX_SHADER, name, defines, vertex_str);
+        create_shader_helper(GL_VERTEX_SHADER, defines, vertex_str);
 #if defined(NANOGUI_USE_OPENGL)
     m_geometry_shader =
-        create_shader_helper(GL_GEOMETRY_SHADER, name, defines, geometry_str);
+        create_shader_helper(GL_GEOMETRY_SHADER, defines, geometry_str);
 #else
     if (!geometry_str.empty())
         throw std::runtime_error("Geometry shaders are not supported on GLES2!");
 #endif
     m_fragment_shader =
-        create_shader_helper(GL_FRAGMENT_SHADER, name, defines, fragment_str);
+        create_shader_helper(GL_FRAGMENT_SHADER, defines, fragment_str);
 
     if (!m_vertex_shader || !m_fragment_shader)
         return false;
@@ -137,9 +326,40 @@ bool GLShader::init(const std::string &name,
 #if defined(NANOGUI_USE_OPENGL)
     if (m_geometry_shader)
         glAttachShader(m_program_shader, m_geometry_shader);
+
+    if (!m_binary_cache_filename.empty())
+        glProgramParameteri(m_program_shader, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 #endif
 
     glLinkProgram(m_program_shader);
+    m_link_pending = true;
+
+    return true;
+}
+
+bool GLShader::ready() {
+    if (!m_link_pending)
+        return m_program_shader != 0;
+
+    if (parallel_shader_compile == 1) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(m_program_shader, GL_COMPLETION_STATUS_KHR, &completed);
+        if (completed != GL_TRUE)
+            return false;
+    }
+
+    finish_link();
+    return true;
+}
+
+void GLShader::finish_link() {
+    m_link_pending = false;
+
+    check_shader_helper(m_vertex_shader, GL_VERTEX_SHADER, m_name);
+#if defined(NANOGUI_USE_OPENGL)
+    check_shader_helper(m_geometry_shader, GL_GEOMETRY_SHADER, m_name);
+#endif
+    check_shader_helper(m_fragment_shader, GL_FRAGMENT_SHADER, m_name);
 
     GLint status;
     glGetProgramiv(m_program_shader, GL_LINK_STATUS, &status);
@@ -152,10 +372,15 @@ bool GLShader::init(const std::string &name,
         throw std::runtime_error("Shader linking failed!");
     }
 
-    return true;
+#if defined(NANOGUI_USE_OPENGL)
+    if (!m_binary_cache_filename.empty())
+        save_program_binary(m_binary_cache_filename, m_program_shader);
+#endif
 }
 
 void GLShader::bind() {
+    if (m_link_pending)
+        finish_link();
     glUseProgram(m_program_shader);
 #if defined(NANOGUI_USE_OPENGL)
     glBindVertexArray(m_vertex_array_object);
@@ -174,6 +399,9 @@ void GLShader::bind() {
 }
 
 GLint GLShader::attrib(const std::string &name, bool warn) const {
+    /* Locations can only be queried once the program is linked */
+    if (m_link_pending)
+        const_cast<GLShader *>(this)->finish_link();
     GLint id = glGetAttribLocation(m_program_shader, name.c_str());
     if (id == -1 && warn)
         std::cerr << m_name << ": warning: did not find attrib " << name << std::endl;
@@ -181,6 +409,8 @@ GLint GLShader::attrib(const std::string &name, bool warn) const {
 }
 
 GLint GLShader::uniform(const std::string &name, bool warn) const {
+    if (m_link_pending)
+        const_cast<GLShader *>(this)->finish_link();
     GLint id = glGetUniformLocation(m_program_shader, name.c_str());
     if (id == -1 && warn)
         std::cerr << m_name << ": warning: did not find uniform " << name << std::endl;
@@ -324,6 +554,7 @@ void GLShader::draw_array(int type, uint32_t offset, uint32_t count) {
 }
 
 void GLShader::free() {
+    m_link_pending = false;
     for (auto &buf: m_buffer_objects) {
         if (buf.second.owned)
             glDeleteBuffers(1, &buf.second.id);
@@ -454,49 +685,44 @@ void GLFramebuffer::blit() {
 #endif
 }
 
+/// Write an 18 byte header of an uncompressed 32 bit TGA image with bottom-left origin
+static bool write_tga_header(FILE *f, const Vector2i &size) {
+    uint8_t header[18] = {
+        0, /* ID */
+        0, /* Color map */
+        2, /* Image type */
+        0, 0, /* First entry of color map (unused) */
+        0, 0, /* Length of color map (unused) */
+        0, /* Color map entry size (unused) */
+        0, 0, /* X offset */
+        0, 0, /* Y offset */
+        (uint8_t) (size.x() % 256), (uint8_t) (size.x() / 256), /* Width */
+        (uint8_t) (size.y() % 256), (uint8_t) (size.y() / 256), /* Height */
+        32,  /* Bits per pixel */
+        0x00 /* Scan from bottom left (matches glReadPixels) */
+    };
+    return fwrite(header, sizeof(header), 1, f) == 1;
+}
+
 void GLFramebuffer::download_tga(const std::string &filename) {
 #if defined(NANOGUI_USE_OPENGL)
-    uint8_t *temp = new uint8_t[hprod(m_size) * 4];
+    std::vector<uint8_t> temp(hprod(m_size) * 4);
 
     std::cout << "Writing \"" << filename  << "\" (" << m_size.x() << "x" << m_size.y() << ") .. ";
     std::cout.flush();
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
     glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-    glReadPixels(0, 0, m_size.x(), m_size.y(), GL_BGRA, GL_UNSIGNED_BYTE, temp);
+    glReadPixels(0, 0, m_size.x(), m_size.y(), GL_BGRA, GL_UNSIGNED_BYTE, temp.data());
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 
-    uint32_t row_size = m_size.x() * 4;
-    uint32_t half_height = m_size.y() / 2;
-    uint8_t *line = (uint8_t *) alloca(row_size);
-    for (uint32_t i=0, j=m_size.y()-1; i<half_height; ++i) {
-        memcpy(line, temp + i * row_size, row_size);
-        memcpy(temp + i * row_size, temp + j * row_size, row_size);
-        memcpy(temp + j * row_size, line, row_size);
-        j--;
-    }
-
     FILE *tga = fopen(filename.c_str(), "wb");
     if (tga == nullptr)
         throw std::runtime_error("GLFramebuffer::download_tga(): Could not open output file");
-    fputc(0, tga); /* ID */
-    fputc(0, tga); /* Color map */
-    fputc(2, tga); /* Image type */
-    fputc(0, tga); fputc(0, tga); /* First entry of color map (unused) */
-    fputc(0, tga); fputc(0, tga); /* Length of color map (unused) */
-    fputc(0, tga); /* Color map entry size (unused) */
-    fputc(0, tga); fputc(0, tga);  /* X offset */
-    fputc(0, tga); fputc(0, tga);  /* Y offset */
-    fputc(m_size.x() % 256, tga); /* Width */
-    fputc(m_size.x() / 256, tga); /* continued */
-    fputc(m_size.y() % 256, tga); /* Height */
-    fputc(m_size.y() / 256, tga); /* continued */
-    fputc(32, tga);   /* Bits per pixel */
-    fputc(0x20, tga); /* Scan from top left */
-    fwrite(temp, hprod(m_size) * 4, 1, tga);
+    write_tga_header(tga, m_size);
+    fwrite(temp.data(), temp.size(), 1, tga);
     fclose(tga);
 
-    delete[] temp;
     std::cout << "done." << std::endl;
 #else
     (void) filename;
@@ -504,6 +730,242 @@ void GLFramebuffer::download_tga(const std::string &filename) {
 #endif
 }
 
+//  ----------------------------------------------------
+
+GLFrameRecorder::~GLFrameRecorder() {
+    stop_workers();
+    if (m_stream)
+        fclose(m_stream);
+}
+
+void GLFrameRecorder::init(const Vector2i &size, size_t ring_size, size_t thread_count) {
+#if defined(NANOGUI_USE_OPENGL)
+    if (!m_slots.empty())
+        free();
+    if (ring_size == 0)
+        throw std::runtime_error("GLFrameRecorder::init(): ring size must be nonzero!");
+
+    m_size = size;
+    m_frame_bytes = (size_t) hprod(size) * 4;
+    m_thread_count = std::max(thread_count, (size_t) 1);
+    m_head = m_frame_count = 0;
+    m_frames_dropped = 0;
+    m_slots.resize(ring_size);
+
+    for (Slot &slot : m_slots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) m_frame_bytes,
+                     nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#else
+    (void) size; (void) ring_size; (void) thread_count;
+    throw std::runtime_error("GLFrameRecorder::init(): Unimplemented for GLES2!");
+#endif
+}
+
+void GLFrameRecorder::free() {
+#if defined(NANOGUI_USE_OPENGL)
+    stop();
+    for (Slot &slot : m_slots) {
+        if (slot.fence)
+            glDeleteSync((GLsync) slot.fence);
+        glDeleteBuffers(1, &slot.pbo);
+    }
+    m_slots.clear();
+    m_buffer_pool.clear();
+#endif
+}
+
+void GLFrameRecorder::start_sequence(const std::string &pattern, Format format) {
+    stop();
+    m_pattern = pattern;
+    m_format = format;
+    start_workers(m_thread_count);
+}
+
+void GLFrameRecorder::start_stream(const std::string &filename) {
+    stop();
+    m_stream = fopen(filename.c_str(), "wb");
+    if (!m_stream)
+        throw std::runtime_error("GLFrameRecorder::start_stream(): Could not open \"" +
+                                 filename + "\"");
+    /* A single worker keeps the frames of the stream in order */
+    start_workers(1);
+}
+
+void GLFrameRecorder::stop() {
+    flush();
+    stop_workers();
+    m_pattern.clear();
+    if (m_stream) {
+        fclose(m_stream);
+        m_stream = nullptr;
+    }
+}
+
+void GLFrameRecorder::capture(GLuint framebuffer) {
+#if defined(NANOGUI_USE_OPENGL)
+    if (m_slots.empty())
+        throw std::runtime_error("GLFrameRecorder::capture(): init() must be called first!");
+
+    /* Deliver frames whose read-back already completed (oldest first, without
+       blocking), stopping at the first one that is still pending */
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        Slot &slot = m_slots[(m_head + i) % m_slots.size()];
+        if (!slot.fence)
+            continue;
+        GLenum rv = glClientWaitSync((GLsync) slot.fence, 0, 0);
+        if (rv != GL_ALREADY_SIGNALED && rv != GL_CONDITION_SATISFIED)
+            break;
+        retire(slot);
+    }
+
+    /* The ring is full and the oldest read-back is still pending: wait for it */
+    Slot &slot = m_slots[m_head];
+    if (slot.fence)
+        retire(slot);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glReadPixels(0, 0, m_size.x(), m_size.y(), GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.frame = m_frame_count++;
+    m_head = (m_head + 1) % m_slots.size();
+#else
+    (void) framebuffer;
+    throw std::runtime_error("GLFrameRecorder::capture(): Unimplemented for GLES2!");
+#endif
+}
+
+void GLFrameRecorder::flush() {
+#if defined(NANOGUI_USE_OPENGL)
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        Slot &slot = m_slots[(m_head + i) % m_slots.size()];
+        if (slot.fence)
+            retire(slot);
+    }
+#endif
+    std::unique_lock<std::mutex> guard(m_mutex);
+    m_idle_cond.wait(guard, [&] { return m_jobs.empty() && m_jobs_active == 0; });
+}
+
+void GLFrameRecorder::retire(Slot &slot) {
+#if defined(NANOGUI_USE_OPENGL)
+    GLsync fence = (GLsync) slot.fence;
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED)
+        ;
+    glDeleteSync(fence);
+    slot.fence = nullptr;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const uint8_t *data = (const uint8_t *) glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr) m_frame_bytes, GL_MAP_READ_BIT);
+    if (data) {
+        if (m_frame_callback)
+            m_frame_callback(data, m_size, slot.frame);
+        if (!m_workers.empty())
+            submit(slot.frame, data);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#else
+    (void) slot;
+#endif
+}
+
+void GLFrameRecorder::submit(size_t frame, const uint8_t *data) {
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_jobs.size() >= m_max_queued_frames) {
+            m_frames_dropped++;
+            return;
+        }
+        if (!m_buffer_pool.empty()) {
+            buffer = std::move(m_buffer_pool.back());
+            m_buffer_pool.pop_back();
+        }
+    }
+
+    buffer.assign(data, data + m_frame_bytes);
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_jobs.push_back(Job{ frame, std::move(buffer) });
+    }
+    m_jobs_cond.notify_one();
+}
+
+void GLFrameRecorder::write(const Job &job) {
+    if (m_stream) {
+        if (fwrite(job.data.data(), job.data.size(), 1, m_stream) != 1)
+            std::cerr << "GLFrameRecorder: could not write frame " << job.frame
+                      << " to stream!" << std::endl;
+        return;
+    }
+
+    char filename[4096];
+    snprintf(filename, sizeof(filename), m_pattern.c_str(), (int) job.frame);
+
+    FILE *f = fopen(filename, "wb");
+    bool success = f != nullptr;
+    if (success && m_format == Format::TGA)
+        success = write_tga_header(f, m_size);
+    if (success)
+        success = fwrite(job.data.data(), job.data.size(), 1, f) == 1;
+    if (f)
+        fclose(f);
+
+    if (!success)
+        std::cerr << "GLFrameRecorder: could not write \"" << filename << "\"!"
+                  << std::endl;
+}
+
+void GLFrameRecorder::start_workers(size_t count) {
+    m_stop = false;
+    for (size_t i = 0; i < count; ++i) {
+        m_workers.emplace_back([this] {
+            std::unique_lock<std::mutex> guard(m_mutex);
+            while (true) {
+                m_jobs_cond.wait(guard, [&] { return m_stop || !m_jobs.empty(); });
+                if (m_jobs.empty())
+                    break;
+
+                Job job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+                m_jobs_active++;
+                guard.unlock();
+
+                write(job);
+
+                guard.lock();
+                m_buffer_pool.push_back(std::move(job.data));
+                m_jobs_active--;
+                if (m_jobs.empty() && m_jobs_active == 0)
+                    m_idle_cond.notify_all();
+            }
+        });
+    }
+}
+
+void GLFrameRecorder::stop_workers() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+    }
+    m_jobs_cond.notify_all();
+    for (std::thread &t : m_workers)
+        t.join();
+    m_workers.clear();
+    m_stop = false;
+}
+
 NAMESPACE_END(nanogui)
 
 #endif
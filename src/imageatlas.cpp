@@ -0,0 +1,113 @@
+/*
+    src/imageatlas.cpp -- Shelf-packed atlas of small RGBA images
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/imageatlas.h>
+#include <nanogui/opengl.h>
+#include <algorithm>
+
+NAMESPACE_BEGIN(nanogui)
+
+ImageAtlas::ImageAtlas(NVGcontext *ctx, int page_size, int padding)
+    : m_ctx(ctx), m_page_size(page_size), m_padding(padding) { }
+
+ImageAtlas::~ImageAtlas() {
+    clear();
+}
+
+bool ImageAtlas::allocate(Page &page, int width, int height, int &x, int &y) {
+    /* Pick the shelf that wastes the least height */
+    Shelf *best = nullptr;
+    for (Shelf &shelf : page.shelves) {
+        if (shelf.height < height || shelf.x + width > m_page_size)
+            continue;
+        if (!best || shelf.height < best->height)
+            best = &shelf;
+    }
+
+    if (!best) {
+        int top = page.shelves.empty() ? 0 :
+            page.shelves.back().y + page.shelves.back().height;
+        if (top + height > m_page_size)
+            return false;
+        page.shelves.push_back(Shelf{ top, height, 0 });
+        best = &page.shelves.back();
+    }
+
+    x = best->x;
+    y = best->y;
+    best->x += width;
+    return true;
+}
+
+ImageAtlas::Region ImageAtlas::add(int width, int height, const uint8_t *data) {
+    Region region;
+    int pw = width + m_padding, ph = height + m_padding;
+    if (width <= 0 || height <= 0 || pw > m_page_size || ph > m_page_size)
+        return region;
+
+    int x = 0, y = 0;
+    Page *page = nullptr;
+    for (Page &p : m_pages) {
+        if (allocate(p, pw, ph, x, y)) {
+            page = &p;
+            break;
+        }
+    }
+
+    if (!page) {
+        Page p;
+        p.data.resize((size_t) m_page_size * m_page_size * 4, 0);
+        p.image = nvgCreateImageRGBA(m_ctx, m_page_size, m_page_size, 0, p.data.data());
+        if (p.image == 0)
+            throw std::runtime_error("ImageAtlas::add(): could not create a page!");
+        p.dirty_begin = m_page_size;
+        p.dirty_end = 0;
+        m_pages.push_back(std::move(p));
+        page = &m_pages.back();
+        allocate(*page, pw, ph, x, y);
+    }
+
+    size_t row = (size_t) width * 4;
+    for (int i = 0; i < height; ++i)
+        memcpy(page->data.data() + ((size_t) (y + i) * m_page_size + x) * 4,
+               data + i * row, row);
+    page->dirty_begin = std::min(page->dirty_begin, y);
+    page->dirty_end = std::max(page->dirty_end, y + height);
+
+    region.image = page->image;
+    region.x = x;
+    region.y = y;
+    region.width = width;
+    region.height = height;
+    return region;
+}
+
+void ImageAtlas::upload() {
+    NVGparams *params = nvgInternalParams(m_ctx);
+    for (Page &page : m_pages) {
+        if (page.dirty_begin >= page.dirty_end)
+            continue;
+        /* Only transfer the modified rows; the data pointer refers to the whole page */
+        params->renderUpdateTexture(params->userPtr, page.image, 0, page.dirty_begin,
+                                    m_page_size, page.dirty_end - page.dirty_begin,
+                                    page.data.data());
+        page.dirty_begin = m_page_size;
+        page.dirty_end = 0;
+    }
+}
+
+void ImageAtlas::clear() {
+    for (Page &page : m_pages)
+        nvgDeleteImage(m_ctx, page.image);
+    m_pages.clear();
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,248 @@
+/*
+    src/imagecache.cpp -- Per-context cache of NanoVG images with LRU
+    eviction
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/imagecache.h>
+#include <nanogui/opengl.h>
+#include <map>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Caches of all NanoVG contexts
+static std::map<NVGcontext *, ref<ImageCache>> image_caches;
+static std::mutex image_caches_mutex;
+
+ImageCache *ImageCache::get(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(image_caches_mutex);
+    ref<ImageCache> &cache = image_caches[ctx];
+    if (!cache)
+        cache = new ImageCache(ctx);
+    return cache.get();
+}
+
+void ImageCache::release(NVGcontext *ctx) {
+    ref<ImageCache> cache;
+    {
+        std::lock_guard<std::mutex> guard(image_caches_mutex);
+        auto it = image_caches.find(ctx);
+        if (it == image_caches.end())
+            return;
+        cache = it->second;
+        image_caches.erase(it);
+    }
+    cache->clear();
+}
+
+ImageCache::~ImageCache() {
+    /* Images are deleted by clear() in release(), while the context still exists */
+}
+
+int ImageCache::load_file(const std::string &filename, int flags, bool evictable) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_by_key.find(filename);
+    if (it != m_by_key.end()) {
+        use(it->second);
+        return it->second->image;
+    }
+
+    Source source;
+    source.key = filename;
+    source.filename = filename;
+    source.flags = flags;
+    int image = create(source);
+    if (image == 0)
+        throw std::runtime_error("ImageCache::load_file(): could not load \"" +
+                                 filename + "\"!");
+    return add(std::move(source), image, evictable);
+}
+
+int ImageCache::load_mem(const std::string &key, const uint8_t *data, size_t size,
+                         int flags, bool evictable) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_by_key.find(key);
+    if (it != m_by_key.end()) {
+        use(it->second);
+        return it->second->image;
+    }
+
+    Source source;
+    source.key = key;
+    source.data = data;
+    source.size = size;
+    source.flags = flags;
+    int image = create(source);
+    if (image == 0)
+        throw std::runtime_error("ImageCache::load_mem(): could not decode \"" +
+                                 key + "\"!");
+    return add(std::move(source), image, evictable);
+}
+
+int ImageCache::insert(const std::string &key, int image) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_by_key.find(key);
+    if (it != m_by_key.end())
+        remove(it->second, true);
+    Source source;
+    source.key = key;
+    return add(std::move(source), image, false);
+}
+
+int ImageCache::find(const std::string &key) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_by_key.find(key);
+    if (it == m_by_key.end())
+        return 0;
+    use(it->second);
+    return it->second->image;
+}
+
+int ImageCache::touch(int image) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_by_image.find(image);
+    if (it != m_by_image.end()) {
+        use(it->second);
+        return image;
+    }
+
+    auto it2 = m_evicted.find(image);
+    if (it2 == m_evicted.end())
+        return image; /* Not managed by this cache */
+
+    Source source = std::move(it2->second);
+    m_evicted.erase(it2);
+
+    /* The image may have been loaded again under its key in the meantime */
+    auto it3 = m_by_key.find(source.key);
+    if (it3 != m_by_key.end()) {
+        use(it3->second);
+        return it3->second->image;
+    }
+
+    int new_image = create(source);
+    if (new_image == 0)
+        return 0;
+    return add(std::move(source), new_image, true);
+}
+
+void ImageCache::invalidate(const std::string &key) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_by_key.find(key);
+    if (it != m_by_key.end())
+        remove(it->second, true);
+    for (auto it2 = m_evicted.begin(); it2 != m_evicted.end(); ) {
+        if (it2->second.key == key)
+            it2 = m_evicted.erase(it2);
+        else
+            ++it2;
+    }
+}
+
+void ImageCache::clear() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (Entry &entry : m_entries)
+        nvgDeleteImage(m_ctx, entry.image);
+    m_entries.clear();
+    m_by_key.clear();
+    m_by_image.clear();
+    m_evicted.clear();
+    m_evicted_order.clear();
+    m_memory_usage = 0;
+}
+
+void ImageCache::next_frame() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_frame++;
+    trim();
+}
+
+void ImageCache::set_budget(size_t budget) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_budget = budget;
+    trim();
+}
+
+size_t ImageCache::memory_usage() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_memory_usage;
+}
+
+size_t ImageCache::size() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_entries.size();
+}
+
+int ImageCache::create(const Source &source) {
+    if (!source.filename.empty())
+        return nvgCreateImage(m_ctx, source.filename.c_str(), source.flags);
+    else if (source.data)
+        return nvgCreateImageMem(m_ctx, source.flags, (unsigned char *) source.data,
+                                 (int) source.size);
+    return 0;
+}
+
+int ImageCache::add(Source &&source, int image, bool evictable) {
+    int w = 0, h = 0;
+    nvgImageSize(m_ctx, image, &w, &h);
+    size_t bytes = (size_t) w * (size_t) h * 4;
+    if (source.flags & NVG_IMAGE_GENERATE_MIPMAPS)
+        bytes += bytes / 3;
+
+    std::string key = source.key;
+    m_entries.push_front(Entry{ std::move(source), image, bytes, m_frame, evictable });
+    m_by_key[key] = m_entries.begin();
+    m_by_image[image] = m_entries.begin();
+    m_memory_usage += bytes;
+
+    trim();
+    return image;
+}
+
+void ImageCache::use(List::iterator it) {
+    it->last_use = m_frame;
+    m_entries.splice(m_entries.begin(), m_entries, it);
+}
+
+void ImageCache::remove(List::iterator it, bool delete_image) {
+    if (delete_image)
+        nvgDeleteImage(m_ctx, it->image);
+    m_memory_usage -= it->bytes;
+    m_by_key.erase(it->source.key);
+    m_by_image.erase(it->image);
+    m_entries.erase(it);
+}
+
+void ImageCache::trim() {
+    auto it = m_entries.end();
+    while (m_memory_usage > m_budget && it != m_entries.begin()) {
+        --it;
+        /* Entries are ordered by last use: the remaining ones were used in this
+           or the previous frame (which has just ended when called by next_frame()) */
+        if (it->last_use + 1 >= m_frame)
+            break;
+        if (!it->evictable)
+            continue;
+
+        if (m_evicted_order.size() == max_evicted) {
+            m_evicted.erase(m_evicted_order.front());
+            m_evicted_order.pop_front();
+        }
+        m_evicted_order.push_back(it->image);
+        m_evicted[it->image] = std::move(it->source);
+        nvgDeleteImage(m_ctx, it->image);
+        m_memory_usage -= it->bytes;
+        m_by_key.erase(m_evicted[it->image].key);
+        m_by_image.erase(it->image);
+        it = m_entries.erase(it);
+        m_evictions++;
+    }
+}
+
+NAMESPACE_END(nanogui)
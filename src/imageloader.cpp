@@ -0,0 +1,336 @@
+/*
+    src/imageloader.cpp -- Asynchronous loader generating thumbnails of
+    a directory of images
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/threadpool.h>
+#include <nanogui/screen.h>
+#include <nanogui/opengl.h>
+#include <stb_image.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <unordered_set>
+#include <algorithm>
+
+NAMESPACE_BEGIN(nanogui)
+
+extern std::vector<std::string> __nanogui_list_images(const std::string &path);
+
+/// Magic number at the beginning of thumbnail cache files ("NGTH")
+static const uint32_t thumbnail_magic = 0x4854474E;
+
+/// Largest side of a thumbnail accepted from the on-disk cache
+static const uint64_t max_thumbnail_extent = 16384;
+
+/**
+ * Downsample an RGBA image using a separable box filter: every output pixel
+ * is the average of the input pixels covering it. Both passes traverse the
+ * images row by row, hence all memory accesses are sequential; the inner
+ * loop of the vertical pass runs over entire rows, which compilers vectorize.
+ */
+static void downsample_box(const uint8_t *src, int sw, int sh,
+                           uint8_t *dst, int dw, int dh) {
+    /* Input columns covered by each output column */
+    std::vector<int> x0(dw), xn(dw);
+    for (int x = 0; x < dw; ++x) {
+        x0[x] = (int) ((int64_t) x * sw / dw);
+        xn[x] = std::max(x0[x] + 1, (int) ((int64_t) (x + 1) * sw / dw)) - x0[x];
+    }
+
+    /* Horizontal pass: sw x sh -> dw x sh */
+    std::vector<uint8_t> tmp((size_t) dw * sh * 4);
+    for (int y = 0; y < sh; ++y) {
+        const uint8_t *s_row = src + (size_t) y * sw * 4;
+        uint8_t *t = tmp.data() + (size_t) y * dw * 4;
+        for (int x = 0; x < dw; ++x, t += 4) {
+            const uint8_t *s = s_row + (size_t) x0[x] * 4;
+            int n = xn[x];
+            uint32_t acc[4] = { 0, 0, 0, 0 };
+            for (int i = 0; i < n; ++i)
+                for (int c = 0; c < 4; ++c)
+                    acc[c] += s[i * 4 + c];
+            for (int c = 0; c < 4; ++c)
+                t[c] = (uint8_t) ((acc[c] + n / 2) / n);
+        }
+    }
+
+    /* Vertical pass: dw x sh -> dw x dh */
+    size_t row = (size_t) dw * 4;
+    std::vector<uint32_t> acc(row);
+    for (int y = 0; y < dh; ++y) {
+        int y0 = (int) ((int64_t) y * sh / dh),
+            y1 = std::max(y0 + 1, (int) ((int64_t) (y + 1) * sh / dh)),
+            n = y1 - y0;
+        std::fill(acc.begin(), acc.end(), 0u);
+        for (int j = y0; j < y1; ++j) {
+            const uint8_t *t = tmp.data() + (size_t) j * row;
+            for (size_t i = 0; i < row; ++i)
+                acc[i] += t[i];
+        }
+        uint8_t *d = dst + (size_t) y * row;
+        for (size_t i = 0; i < row; ++i)
+            d[i] = (uint8_t) ((acc[i] + n / 2) / n);
+    }
+}
+
+ImageLoader::ImageLoader(Screen *screen, int thumbnail_size, size_t thread_count)
+    : m_screen(screen), m_ctx(screen->nvg_context()),
+      m_thumbnail_size(thumbnail_size), m_max_tasks(thread_count) {
+    /* Decoding shares the threads of the pool with all other background tasks */
+    if (m_max_tasks == 0)
+        m_max_tasks = ThreadPool::get()->thread_count();
+}
+
+ImageLoader::~ImageLoader() {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    m_stop = true;
+    m_jobs.clear();
+    /* Queued tasks refer to the loader: wait until all of them have finished */
+    m_cond.wait(guard, [&] { return m_tasks == 0; });
+}
+
+void ImageLoader::load_directory(const std::string &path) {
+    std::vector<std::string> filenames = __nanogui_list_images(path);
+    ImageCache *cache = ImageCache::get(m_ctx);
+    std::string prefix = "thumbnail:" + std::to_string(m_thumbnail_size) + ":";
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    /* Release the thumbnails of images that are not part of the new directory
+       (deleting textures requires the OpenGL context, hence update() does it) */
+    std::unordered_set<std::string> keys;
+    for (const std::string &filename : filenames)
+        keys.insert(prefix + filename);
+    auto it = std::partition(m_keys.begin(), m_keys.end(),
+                             [&](const std::string &key) { return keys.count(key) != 0; });
+    m_stale_keys.insert(m_stale_keys.end(), std::make_move_iterator(it),
+                        std::make_move_iterator(m_keys.end()));
+    m_keys.erase(it, m_keys.end());
+
+    m_generation++;
+    m_jobs.clear();
+    m_results.clear();
+    m_images.clear();
+    m_regions.assign(filenames.size(), ImageAtlas::Region());
+    m_loaded = 0;
+    if (m_atlas)
+        m_atlas->clear();
+
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        const std::string &filename = filenames[i];
+        /* Thumbnails uploaded earlier are available immediately */
+        int image = cache->find(prefix + filename);
+        m_images.emplace_back(image, filename.substr(0, filename.length() - 4));
+        if (image != 0)
+            m_loaded++;
+        else
+            m_jobs.push_back(Job{ i, m_generation, filename });
+    }
+    schedule();
+}
+
+void ImageLoader::cancel() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_jobs.clear();
+}
+
+bool ImageLoader::update(size_t max_uploads) {
+    ImageCache *cache = ImageCache::get(m_ctx);
+    std::string prefix = "thumbnail:" + std::to_string(m_thumbnail_size) + ":";
+    bool changed = false;
+
+    std::vector<std::string> stale_keys;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        stale_keys.swap(m_stale_keys);
+    }
+    for (const std::string &key : stale_keys)
+        cache->invalidate(key);
+
+    for (size_t i = 0; i < max_uploads; ++i) {
+        Result result;
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (m_results.empty())
+                break;
+            result = std::move(m_results.front());
+            m_results.pop_front();
+            if (result.generation != m_generation)
+                continue;
+        }
+
+        auto &entry = m_images[result.index];
+        ImageAtlas::Region region;
+        if (m_atlas)
+            region = m_atlas->add(result.width, result.height, result.data.data());
+
+        if (region.image != 0) {
+            entry.first = region.image;
+            m_regions[result.index] = region;
+        } else {
+            int image = nvgCreateImageRGBA(m_ctx, result.width, result.height, 0,
+                                           result.data.data());
+            if (image == 0)
+                continue;
+            entry.first = cache->insert(prefix + result.filename, image);
+            m_keys.push_back(prefix + result.filename);
+        }
+        m_loaded++;
+        changed = true;
+        if (m_callback)
+            m_callback(result.index, entry.first);
+    }
+
+    if (m_atlas && changed)
+        m_atlas->upload();
+
+    /* More thumbnails are waiting: draw another frame soon */
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_results.empty())
+        m_screen->redraw();
+
+    return changed;
+}
+
+void ImageLoader::schedule() {
+    /* One image per task, so that other users of the pool are not starved */
+    while (!m_stop && m_tasks < m_max_tasks && m_tasks < m_jobs.size()) {
+        m_tasks++;
+        ThreadPool::get()->enqueue([this] { process(); });
+    }
+}
+
+void ImageLoader::process() {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    if (!m_stop && !m_jobs.empty()) {
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        guard.unlock();
+
+        Result result;
+        result.index = job.index;
+        result.generation = job.generation;
+        result.filename = job.filename;
+        bool success = decode(job, result);
+
+        guard.lock();
+        if (success && job.generation == m_generation) {
+            m_results.push_back(std::move(result));
+            m_screen->redraw();
+        }
+    }
+    m_tasks--;
+    schedule();
+    m_cond.notify_all();
+}
+
+bool ImageLoader::decode(const Job &job, Result &result) {
+    std::string cache_file = cache_filename(job.filename);
+
+    /* Try the on-disk cache first */
+    if (!cache_file.empty()) {
+        FILE *f = fopen(cache_file.c_str(), "rb");
+        if (f) {
+            uint32_t header[3];
+            bool success = fread(header, sizeof(header), 1, f) == 1 &&
+                           header[0] == thumbnail_magic;
+
+            /* Reject truncated or corrupt files before allocating memory */
+            if (success) {
+                long file_size = -1;
+                if (fseek(f, 0, SEEK_END) == 0)
+                    file_size = ftell(f);
+                uint64_t w = header[1], h = header[2];
+                success = w > 0 && h > 0 &&
+                          std::min(w, h) <= (uint64_t) m_thumbnail_size &&
+                          std::max(w, h) <= max_thumbnail_extent &&
+                          file_size == (long) (sizeof(header) + w * h * 4) &&
+                          fseek(f, (long) sizeof(header), SEEK_SET) == 0;
+            }
+
+            if (success) {
+                result.width = (int) header[1];
+                result.height = (int) header[2];
+                result.data.resize((size_t) result.width * result.height * 4);
+                success = fread(result.data.data(), result.data.size(), 1, f) == 1;
+            }
+            fclose(f);
+            if (success)
+                return true;
+        }
+    }
+
+    int w, h, n;
+    uint8_t *data = stbi_load(job.filename.c_str(), &w, &h, &n, 4);
+    if (!data)
+        return false;
+
+    int min_size = std::min(w, h);
+    if (min_size > m_thumbnail_size) {
+        result.width = std::max(1, (int) ((int64_t) w * m_thumbnail_size / min_size));
+        result.height = std::max(1, (int) ((int64_t) h * m_thumbnail_size / min_size));
+        result.data.resize((size_t) result.width * result.height * 4);
+        downsample_box(data, w, h, result.data.data(), result.width, result.height);
+    } else {
+        result.width = w;
+        result.height = h;
+        result.data.assign(data, data + (size_t) w * h * 4);
+    }
+    stbi_image_free(data);
+
+    if (!cache_file.empty()) {
+        /* Write to a temporary file first, so that readers never see partial files */
+        std::string tmp = cache_file + ".tmp" +
+            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        FILE *f = fopen(tmp.c_str(), "wb");
+        if (f) {
+            uint32_t header[3] = { thumbnail_magic, (uint32_t) result.width,
+                                   (uint32_t) result.height };
+            bool success = fwrite(header, sizeof(header), 1, f) == 1 &&
+                           fwrite(result.data.data(), result.data.size(), 1, f) == 1;
+            success &= fclose(f) == 0;
+            if (!success || std::rename(tmp.c_str(), cache_file.c_str()) != 0)
+                std::remove(tmp.c_str());
+        }
+    }
+
+    return true;
+}
+
+std::string ImageLoader::cache_filename(const std::string &filename) const {
+    if (m_cache_directory.empty())
+        return std::string();
+
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0)
+        return std::string();
+
+    /* FNV-1a hash of the filename, file size, modification time, and thumbnail size */
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto add = [&hash](const void *ptr, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= ((const uint8_t *) ptr)[i];
+            hash *= 0x100000001b3ull;
+        }
+    };
+    uint64_t size = (uint64_t) st.st_size, mtime = (uint64_t) st.st_mtime;
+    add(filename.data(), filename.size());
+    add(&size, sizeof(size));
+    add(&mtime, sizeof(mtime));
+    add(&m_thumbnail_size, sizeof(m_thumbnail_size));
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%016llx.thumb", (unsigned long long) hash);
+    return m_cache_directory + "/" + buf;
+}
+
+NAMESPACE_END(nanogui)
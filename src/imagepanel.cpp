@@ -14,6 +14,7 @@
 
 #include <nanogui/imagepanel.h>
 #include <nanogui/opengl.h>
+#include <nanogui/imagecache.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -21,6 +22,17 @@ ImagePanel::ImagePanel(Widget *parent)
     : Widget(parent), m_thumb_size(64), m_spacing(10), m_margin(10),
       m_mouse_index(-1) {}
 
+void ImagePanel::set_loader(ImageLoader *loader) {
+    m_loader = loader;
+    if (!m_loader)
+        return;
+    /* Pack the thumbnails into shared textures, so that drawing them does not
+       switch textures for every image */
+    if (!m_loader->atlas())
+        m_loader->set_atlas(new ImageAtlas(m_loader->nvg_context()));
+    m_images = m_loader->images();
+}
+
 Vector2i ImagePanel::grid_size() const {
     int n_cols = 1 + std::max(0,
         (int) ((m_size.x() - 2 * m_margin - m_thumb_size) /
@@ -63,14 +75,62 @@ Vector2i ImagePanel::preferred_size(NVGcontext *) const {
 }
 
 void ImagePanel::draw(NVGcontext* ctx) {
+    if (m_loader && (m_loader->update() || m_images.size() != m_loader->total()))
+        m_images = m_loader->images();
+    if (m_images.empty())
+        return;
+
     Vector2i grid = grid_size();
+    ImageCache *cache = ImageCache::get(ctx);
+    const std::vector<ImageAtlas::Region> *regions =
+        (m_loader && m_loader->atlas()) ? &m_loader->regions() : nullptr;
+    int pitch = m_thumb_size + m_spacing;
+
+    /* Only draw the rows intersecting the visible part of all ancestors (e.g. a VScrollPanel) */
+    int top = 0, bottom = m_size.y();
+    Vector2i offset = m_pos;
+    for (const Widget *w = parent(); w; w = w->parent()) {
+        top = std::max(top, -offset.y());
+        bottom = std::min(bottom, w->height() - offset.y());
+        offset += w->position();
+    }
+    size_t first = (size_t) std::max(0, (top - m_margin) / pitch) * grid.x(),
+           last = std::min(m_images.size(),
+                           (size_t) std::max(0, (bottom - m_margin) / pitch + 1) * grid.x());
+    if (first >= last)
+        return;
+
+    auto cell = [&](size_t i) {
+        return m_pos + Vector2i(m_margin) +
+            Vector2i((int) i % grid.x(), (int) i / grid.x()) * pitch;
+    };
+
+    /* Thumbnails: each one requires its own fill (and thus draw call), but
+       thumbnails packed into an atlas share a few textures */
+    bool loading = false;
+    for (size_t i = first; i < last; ++i) {
+        /* Keep the image cached (reloading it if it was evicted) */
+        int image = m_images[i].first = cache->touch(m_images[i].first);
+        if (image == 0) {
+            loading = true;
+            continue;
+        }
 
-    for (size_t i=0; i<m_images.size(); ++i) {
-        Vector2i p = m_pos + Vector2i(m_margin) +
-            Vector2i((int) i % grid.x(), (int) i / grid.x()) * (m_thumb_size + m_spacing);
+        const ImageAtlas::Region *region = nullptr;
+        if (regions && i < regions->size() && (*regions)[i].image == image)
+            region = &(*regions)[i];
+
+        Vector2i p = cell(i);
         int imgw, imgh;
+        if (region) {
+            imgw = region->width;
+            imgh = region->height;
+        } else {
+            nvgImageSize(ctx, image, &imgw, &imgh);
+        }
+        if (imgw == 0 || imgh == 0)
+            continue;
 
-        nvgImageSize(ctx, m_images[i].first, &imgw, &imgh);
         float iw, ih, ix, iy;
         if (imgw < imgh) {
             iw = m_thumb_size;
@@ -84,15 +144,41 @@ void ImagePanel::draw(NVGcontext* ctx) {
             iy = 0;
         }
 
-        NVGpaint img_paint = nvgImagePattern(
-            ctx, p.x() + ix, p.y()+ iy, iw, ih, 0, m_images[i].first,
-            m_mouse_index == (int)i ? 1.0 : 0.7);
+        float alpha = m_mouse_index == (int)i ? 1.0 : 0.7;
+        NVGpaint img_paint;
+        if (region) {
+            /* Map the whole atlas page such that the region covers the thumbnail */
+            float scale = iw / imgw, page_size = m_loader->atlas()->page_size() * scale;
+            img_paint = nvgImagePattern(
+                ctx, p.x() + ix - region->x * scale, p.y() + iy - region->y * scale,
+                page_size, page_size, 0, image, alpha);
+        } else {
+            img_paint = nvgImagePattern(
+                ctx, p.x() + ix, p.y()+ iy, iw, ih, 0, image, alpha);
+        }
 
         nvgBeginPath(ctx);
         nvgRoundedRect(ctx, p.x(), p.y(), m_thumb_size, m_thumb_size, 5);
         nvgFillPaint(ctx, img_paint);
         nvgFill(ctx);
+    }
 
+    /* Placeholders of images that are still loading (a single fill) */
+    if (loading) {
+        nvgBeginPath(ctx);
+        for (size_t i = first; i < last; ++i) {
+            if (m_images[i].first != 0)
+                continue;
+            Vector2i p = cell(i);
+            nvgRoundedRect(ctx, p.x(), p.y(), m_thumb_size, m_thumb_size, 5);
+        }
+        nvgFillColor(ctx, m_theme->m_border_medium);
+        nvgFill(ctx);
+    }
+
+    /* Drop shadows */
+    for (size_t i = first; i < last; ++i) {
+        Vector2i p = cell(i);
         NVGpaint shadow_paint =
             nvgBoxGradient(ctx, p.x() - 1, p.y(), m_thumb_size + 2, m_thumb_size + 2, 5, 3,
                            nvgRGBA(0, 0, 0, 128), nvgRGBA(0, 0, 0, 0));
@@ -102,13 +188,17 @@ void ImagePanel::draw(NVGcontext* ctx) {
         nvgPathWinding(ctx, NVG_HOLE);
         nvgFillPaint(ctx, shadow_paint);
         nvgFill(ctx);
+    }
 
-        nvgBeginPath(ctx);
+    /* Borders (a single stroke) */
+    nvgBeginPath(ctx);
+    for (size_t i = first; i < last; ++i) {
+        Vector2i p = cell(i);
         nvgRoundedRect(ctx, p.x()+0.5f,p.y()+0.5f, m_thumb_size-1,m_thumb_size-1, 4-0.5f);
-        nvgStrokeWidth(ctx, 1.0f);
-        nvgStrokeColor(ctx, nvgRGBA(255,255,255,80));
-        nvgStroke(ctx);
     }
+    nvgStrokeWidth(ctx, 1.0f);
+    nvgStrokeColor(ctx, nvgRGBA(255,255,255,80));
+    nvgStroke(ctx);
 }
 
 NAMESPACE_END(nanogui)
@@ -323,8 +323,7 @@ void ImageView::draw(NVGcontext* ctx) {
 
     // Calculate several variables that need to be send to OpenGL in order for the image to be
     // properly displayed inside the widget.
-    const Screen* screen = dynamic_cast<const Screen*>(this->window()->parent());
-    assert(screen);
+    const Screen *screen = this->screen();
     Vector2f screen_size(screen->size());
     Vector2f scale_factor = m_scale * image_size_f() / screen_size;
     Vector2f position_in_screen(absolute_position());
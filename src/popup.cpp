@@ -19,6 +19,7 @@ NAMESPACE_BEGIN(nanogui)
 Popup::Popup(Widget *parent, Window *parent_window)
     : Window(parent, ""), m_parent_window(parent_window),
       m_anchor_pos(Vector2i(0, 0)), m_anchor_height(30), m_side(Side::Right) {
+    m_kind |= PopupKind;
 }
 
 void Popup::perform_layout(NVGcontext *ctx) {
@@ -35,8 +36,8 @@ void Popup::perform_layout(NVGcontext *ctx) {
 
 void Popup::refresh_relative_placement() {
     m_parent_window->refresh_relative_placement();
-    m_visible &= m_parent_window->visible_recursive();
-    m_pos = m_parent_window->position() + m_anchor_pos - Vector2i(0, m_anchor_height);
+    set_visible(m_visible && m_parent_window->visible_recursive());
+    set_position(m_parent_window->position() + m_anchor_pos - Vector2i(0, m_anchor_height));
 }
 
 void Popup::draw(NVGcontext* ctx) {
@@ -16,7 +16,10 @@
 #include <nanogui/opengl.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
+#include <nanogui/imagecache.h>
 #include <map>
+#include <mutex>
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -54,6 +57,158 @@ std::map<GLFWwindow *, Screen *> __nanogui_screens;
 static bool glad_initialized = false;
 #endif
 
+/// Should new screens join the OpenGL context group of existing screens?
+static bool screen_context_sharing = false;
+
+/**
+ * Observes the textures NanoVG allocates for its glyph atlas and counts the
+ * render calls by wrapping the render callbacks of a NanoVG context. Text is
+ * the only geometry NanoVG submits with renderTriangles(), hence the atlas
+ * pages are identified by the images passed to it.
+ */
+struct RenderTracker {
+    NVGparams original;
+    /// Number of fills, strokes and triangle batches since the last frame
+    size_t render_calls = 0;
+    /// Postpone flushes and texture deletions (see Screen::draw_all())
+    bool defer = false;
+    std::function<void()> deferred_flush;
+    std::vector<int> deferred_deletes;
+    /// Size and highest row written so far of every atlas page
+    std::map<int, std::pair<Vector2i, int>> pages;
+    /// Atlas page used by the most recent text
+    int current_page = 0;
+    /// Bytes and highest row uploaded during this frame to textures that
+    /// are not known to be atlas pages (yet)
+    std::map<int, std::pair<size_t, int>> other_uploads;
+    size_t evictions = 0;
+    size_t upload_bytes = 0;
+};
+
+/// Trackers indexed by the user pointer of the wrapped NanoVG renderer
+static std::map<void *, RenderTracker> render_trackers;
+static std::mutex render_trackers_mutex;
+
+/// Incremented whenever a tracker is removed (invalidates cached lookups)
+static std::atomic<size_t> render_trackers_generation { 0 };
+
+static RenderTracker &render_tracker(void *uptr) {
+    /* The render callbacks run for every fill and stroke: cache the last
+       lookup per thread, so that render threads do not contend on the mutex */
+    thread_local void *cached_uptr = nullptr;
+    thread_local RenderTracker *cached_tracker = nullptr;
+    thread_local size_t cached_generation = 0;
+
+    size_t generation = render_trackers_generation.load(std::memory_order_acquire);
+    if (cached_tracker && cached_uptr == uptr && cached_generation == generation)
+        return *cached_tracker;
+
+    std::lock_guard<std::mutex> guard(render_trackers_mutex);
+    cached_uptr = uptr;
+    cached_tracker = &render_trackers[uptr];
+    cached_generation = generation;
+    return *cached_tracker;
+}
+
+/// Register a texture drawn as text as an atlas page
+static void glyph_atlas_use_page(RenderTracker &tracker, void *uptr, int image) {
+    if (image == tracker.current_page || image == 0)
+        return;
+    tracker.current_page = image;
+    if (tracker.pages.find(image) != tracker.pages.end())
+        return;
+
+    /* Any page beyond the first is allocated because the atlas overflowed */
+    if (!tracker.pages.empty())
+        tracker.evictions++;
+    int w = 0, h = 0;
+    tracker.original.renderGetTextureSize(uptr, image, &w, &h);
+    auto &page = tracker.pages[image];
+    page = { Vector2i(w, h), 0 };
+
+    /* The glyphs of the text were uploaded before it was drawn */
+    auto it = tracker.other_uploads.find(image);
+    if (it != tracker.other_uploads.end()) {
+        tracker.upload_bytes += it->second.first;
+        page.second = it->second.second;
+        tracker.other_uploads.erase(it);
+    }
+}
+
+static int glyph_atlas_update_texture(void *uptr, int image, int x, int y,
+                                      int w, int h, const unsigned char *data) {
+    RenderTracker &tracker = render_tracker(uptr);
+    size_t bytes = (size_t) w * (size_t) h;
+    auto it = tracker.pages.find(image);
+    if (it != tracker.pages.end()) {
+        tracker.upload_bytes += bytes;
+        it->second.second = std::max(it->second.second, y + h);
+    } else {
+        auto &upload = tracker.other_uploads[image];
+        upload.first += bytes;
+        upload.second = std::max(upload.second, y + h);
+    }
+    return tracker.original.renderUpdateTexture(uptr, image, x, y, w, h, data);
+}
+
+static int glyph_atlas_delete_texture(void *uptr, int image) {
+    RenderTracker &tracker = render_tracker(uptr);
+    tracker.pages.erase(image);
+    tracker.other_uploads.erase(image);
+    if (tracker.current_page == image)
+        tracker.current_page = 0;
+    if (tracker.defer) {
+        /* The deferred flush may still refer to the texture */
+        tracker.deferred_deletes.push_back(image);
+        return 1;
+    }
+    return tracker.original.renderDeleteTexture(uptr, image);
+}
+
+/* The argument lists of the following callbacks differ between NanoVG
+   versions, hence they are deduced from the callback types */
+template <typename... Args> static void counted_render_fill(void *uptr, Args... args) {
+    RenderTracker &tracker = render_tracker(uptr);
+    tracker.render_calls++;
+    tracker.original.renderFill(uptr, args...);
+}
+
+template <typename... Args> static void counted_render_stroke(void *uptr, Args... args) {
+    RenderTracker &tracker = render_tracker(uptr);
+    tracker.render_calls++;
+    tracker.original.renderStroke(uptr, args...);
+}
+
+template <typename... Args>
+static void counted_render_triangles(void *uptr, NVGpaint *paint, Args... args) {
+    RenderTracker &tracker = render_tracker(uptr);
+    tracker.render_calls++;
+    glyph_atlas_use_page(tracker, uptr, paint->image);
+    tracker.original.renderTriangles(uptr, paint, args...);
+}
+
+template <typename... Args> static void deferred_render_flush(void *uptr, Args... args) {
+    RenderTracker &tracker = render_tracker(uptr);
+    if (tracker.defer)
+        tracker.deferred_flush = [&tracker, uptr, args...] {
+            tracker.original.renderFlush(uptr, args...);
+        };
+    else
+        tracker.original.renderFlush(uptr, args...);
+}
+
+/// Execute the flush and texture deletions postponed while RenderTracker::defer was set
+static void run_deferred(RenderTracker &tracker, void *uptr) {
+    tracker.defer = false;
+    if (tracker.deferred_flush) {
+        tracker.deferred_flush();
+        tracker.deferred_flush = nullptr;
+    }
+    for (int image : tracker.deferred_deletes)
+        tracker.original.renderDeleteTexture(uptr, image);
+    tracker.deferred_deletes.clear();
+}
+
 /* Calculate pixel ratio for hi-dpi devices. */
 static float get_pixel_ratio(GLFWwindow *window) {
 /*#if defined(_WIN32)
@@ -144,6 +299,8 @@ Screen::Screen()
       m_cursor(Cursor::Arrow), m_background(0.3f, 0.3f, 0.32f, 1.f),
       m_shutdown_glfw(false), m_fullscreen(false), m_redraw(false) {
     memset(m_cursors, 0, sizeof(GLFWcursor *) * (int) Cursor::CursorCount);
+    m_kind |= ScreenKind;
+    update_owners();
 }
 
 Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
@@ -154,6 +311,8 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
       m_cursor(Cursor::Arrow), m_background(0.3f, 0.3f, 0.32f, 1.f), m_caption(caption),
       m_shutdown_glfw(false), m_fullscreen(fullscreen), m_redraw(false) {
     memset(m_cursors, 0, sizeof(GLFWcursor *) * (int) Cursor::CursorCount);
+    m_kind |= ScreenKind;
+    update_owners();
 
 #if defined(NANOGUI_USE_OPENGL)
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
@@ -181,14 +340,18 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
     glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
     glfwWindowHint(GLFW_RESIZABLE, resizable ? GL_TRUE : GL_FALSE);
 
+    GLFWwindow *share = nullptr;
+    if (screen_context_sharing && !__nanogui_screens.empty())
+        share = __nanogui_screens.begin()->first;
+
     if (fullscreen) {
         GLFWmonitor *monitor = glfwGetPrimaryMonitor();
         const GLFWvidmode *mode = glfwGetVideoMode(monitor);
         m_glfw_window = glfwCreateWindow(mode->width, mode->height,
-                                       caption.c_str(), monitor, nullptr);
+                                       caption.c_str(), monitor, share);
     } else {
         m_glfw_window = glfwCreateWindow(size.x(), size.y(),
-                                       caption.c_str(), nullptr, nullptr);
+                                       caption.c_str(), nullptr, share);
     }
 
     if (!m_glfw_window) {
@@ -236,9 +399,10 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-            if (!s->m_process_events)
-                return;
-            s->cursor_pos_callback_event(x, y);
+            s->dispatch_event([s, x, y] {
+                if (s->m_process_events)
+                    s->cursor_pos_callback_event(x, y);
+            });
         }
     );
 
@@ -248,9 +412,10 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-            if (!s->m_process_events)
-                return;
-            s->mouse_button_callback_event(button, action, modifiers);
+            s->dispatch_event([s, button, action, modifiers] {
+                if (s->m_process_events)
+                    s->mouse_button_callback_event(button, action, modifiers);
+            });
         }
     );
 
@@ -260,9 +425,10 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-            if (!s->m_process_events)
-                return;
-            s->key_callback_event(key, scancode, action, mods);
+            s->dispatch_event([s, key, scancode, action, mods] {
+                if (s->m_process_events)
+                    s->key_callback_event(key, scancode, action, mods);
+            });
         }
     );
 
@@ -272,9 +438,10 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-            if (!s->m_process_events)
-                return;
-            s->char_callback_event(codepoint);
+            s->dispatch_event([s, codepoint] {
+                if (s->m_process_events)
+                    s->char_callback_event(codepoint);
+            });
         }
     );
 
@@ -284,9 +451,16 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-            if (!s->m_process_events)
-                return;
-            s->drop_callback_event(count, filenames);
+            /* The filenames are only valid during the callback */
+            std::vector<std::string> names(filenames, filenames + count);
+            s->dispatch_event([s, names] {
+                if (!s->m_process_events)
+                    return;
+                std::vector<const char *> ptrs;
+                for (const std::string &name : names)
+                    ptrs.push_back(name.c_str());
+                s->drop_callback_event((int) ptrs.size(), ptrs.data());
+            });
         }
     );
 
@@ -296,9 +470,10 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-            if (!s->m_process_events)
-                return;
-            s->scroll_callback_event(x, y);
+            s->dispatch_event([s, x, y] {
+                if (s->m_process_events)
+                    s->scroll_callback_event(x, y);
+            });
         }
     );
 
@@ -312,11 +487,10 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
             if (it == __nanogui_screens.end())
                 return;
             Screen *s = it->second;
-
-            if (!s->m_process_events)
-                return;
-
-            s->resize_callback_event(width, height);
+            s->dispatch_event([s, width, height] {
+                if (s->m_process_events)
+                    s->resize_callback_event(width, height);
+            });
         }
     );
 
@@ -329,7 +503,7 @@ Screen::Screen(const Vector2i &size, const std::string &caption, bool resizable,
 
             Screen *s = it->second;
             // focus_event: 0 when false, 1 when true
-            s->focus_event(focused != 0);
+            s->dispatch_event([s, focused] { s->focus_event(focused != 0); });
         }
     );
     initialize(m_glfw_window, true);
@@ -404,7 +578,18 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw) {
     if (m_nvg_context == nullptr)
         throw std::runtime_error("Could not initialize NanoVG!");
 
-    m_visible = glfwGetWindowAttrib(window, GLFW_VISIBLE) != 0;
+    /* Observe the glyph atlas and count render calls (see glyph_atlas_stats()
+       and render_calls()) */
+    NVGparams *params = nvgInternalParams(m_nvg_context);
+    render_tracker(params->userPtr).original = *params;
+    params->renderUpdateTexture = glyph_atlas_update_texture;
+    params->renderDeleteTexture = glyph_atlas_delete_texture;
+    params->renderFill = counted_render_fill;
+    params->renderStroke = counted_render_stroke;
+    params->renderTriangles = counted_render_triangles;
+    params->renderFlush = deferred_render_flush;
+
+    Widget::set_visible(glfwGetWindowAttrib(window, GLFW_VISIBLE) != 0);
     set_theme(new Theme(m_nvg_context));
     m_mouse_pos = Vector2i(0,0);
     m_mouse_state = m_modifiers = 0;
@@ -423,25 +608,40 @@ void Screen::initialize(GLFWwindow *window, bool shutdown_glfw) {
 }
 
 Screen::~Screen() {
+    if (m_render_thread.joinable())
+        set_threaded_rendering(false);
     __nanogui_screens.erase(m_glfw_window);
     for (int i=0; i < (int) Cursor::CursorCount; ++i) {
         if (m_cursors[i])
             glfwDestroyCursor(m_cursors[i]);
     }
     if (m_nvg_context) {
+        ImageCache::release(m_nvg_context);
+        void *uptr = nvgInternalParams(m_nvg_context)->userPtr;
 #if defined(NANOGUI_USE_OPENGL)
         nvgDeleteGL3(m_nvg_context);
 #else
         nvgDeleteGLES2(m_nvg_context);
 #endif
+        std::lock_guard<std::mutex> guard(render_trackers_mutex);
+        render_trackers.erase(uptr);
+        render_trackers_generation++;
     }
     if (m_glfw_window && m_shutdown_glfw)
         glfwDestroyWindow(m_glfw_window);
 }
 
+void Screen::set_context_sharing(bool value) {
+    screen_context_sharing = value;
+}
+
+bool Screen::context_sharing() {
+    return screen_context_sharing;
+}
+
 void Screen::set_visible(bool visible) {
     if (m_visible != visible) {
-        m_visible = visible;
+        Widget::set_visible(visible);
 
         if (visible)
             glfwShowWindow(m_glfw_window);
@@ -468,43 +668,213 @@ void Screen::set_size(const Vector2i &size) {
 }
 
 void Screen::draw_all() {
-    if (m_redraw) {
-        m_redraw = false;
+    if (m_render_thread.joinable() &&
+        std::this_thread::get_id() != m_render_thread.get_id()) {
+        /* Drawing takes place on the render thread */
+        process_pending_events();
+        if (m_redraw) {
+            std::lock_guard<std::mutex> guard(m_render_mutex);
+            m_render_cond.notify_one();
+        }
+        return;
+    }
 
-        glfwMakeContextCurrent(m_glfw_window);
+    if (!m_render_thread.joinable())
+        process_pending_events();
 
-        #if !defined(EMSCRIPTEN)
-            glfwGetFramebufferSize(m_glfw_window, &m_fbsize[0], &m_fbsize[1]);
-            glfwGetWindowSize(m_glfw_window, &m_size[0], &m_size[1]);
-        #else
-            emscripten_get_canvas_element_size("#canvas", &m_size[0], &m_size[1]);
-            m_fbsize = m_size;
-        #endif
+    if (m_redraw) {
+        m_redraw = false;
+        bool threaded = m_render_thread.joinable();
+        Vector2i fbsize;
+
+        {
+            std::lock_guard<std::recursive_mutex> guard(m_ui_mutex);
+
+            /* The window size can only be queried on the main thread. When
+               rendering on another thread, resize_callback_event() keeps
+               track of it */
+            if (!threaded) {
+                glfwMakeContextCurrent(m_glfw_window);
+
+                #if !defined(EMSCRIPTEN)
+                    glfwGetFramebufferSize(m_glfw_window, &m_fbsize[0], &m_fbsize[1]);
+                    glfwGetWindowSize(m_glfw_window, &m_size[0], &m_size[1]);
+                #else
+                    emscripten_get_canvas_element_size("#canvas", &m_size[0], &m_size[1]);
+                    m_fbsize = m_size;
+                #endif
 
 #if defined(_WIN32) || defined(__linux__) || defined(EMSCRIPTEN)
-        m_fbsize = m_size;
-        m_size = Vector2i(m_size.x() / m_pixel_ratio, m_size.y() / m_pixel_ratio);
+                m_fbsize = m_size;
+                m_size = Vector2i(m_size.x() / m_pixel_ratio, m_size.y() / m_pixel_ratio);
 #else
-        /* Recompute pixel ratio on OSX */
-        if (m_size[0])
-            m_pixel_ratio = (float) m_fbsize[0] / (float) m_size[0];
+                /* Recompute pixel ratio on OSX */
+                if (m_size[0])
+                    m_pixel_ratio = (float) m_fbsize[0] / (float) m_size[0];
 #endif
+            }
+            fbsize = m_fbsize;
+        }
 
         glClearColor(m_background.r(), m_background.g(), m_background.b(), m_background.a());
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-        glViewport(0, 0, m_fbsize[0], m_fbsize[1]);
+        glViewport(0, 0, fbsize[0], fbsize[1]);
 
         draw_contents();
-        draw_widgets();
+
+        /* On the render thread, only building the NanoVG commands requires
+           the widgets; their submission happens after releasing the lock */
+        void *uptr = nvgInternalParams(m_nvg_context)->userPtr;
+        RenderTracker &tracker = render_tracker(uptr);
+        tracker.defer = threaded;
+        {
+            std::lock_guard<std::recursive_mutex> guard(m_ui_mutex);
+            draw_widgets();
+        }
+        run_deferred(tracker, uptr);
 
         glfwSwapBuffers(m_glfw_window);
+
+        if (m_first_frame_time < 0)
+            m_first_frame_time = glfwGetTime();
+    }
+}
+
+void Screen::set_threaded_rendering(bool value) {
+    if (value == m_render_thread.joinable())
+        return;
+
+#if defined(EMSCRIPTEN)
+    throw std::runtime_error("Screen::set_threaded_rendering(): not supported on this platform!");
+#else
+    if (value) {
+        /* The context can only be current on one thread at a time */
+        glfwMakeContextCurrent(nullptr);
+        m_render_stop = false;
+        m_render_thread = std::thread([this] { render_thread(); });
+    } else {
+        {
+            std::lock_guard<std::mutex> guard(m_render_mutex);
+            m_render_stop = true;
+        }
+        m_render_cond.notify_one();
+        m_render_thread.join();
+        glfwMakeContextCurrent(m_glfw_window);
+    }
+#endif
+}
+
+void Screen::dispatch_event(std::function<void()> &&event) {
+    std::unique_lock<std::recursive_mutex> guard(m_ui_mutex, std::try_to_lock);
+    if (!guard.owns_lock()) {
+        /* The render thread is drawing the widgets. Queue the event rather
+           than stalling the event handling of all other screens */
+        std::lock_guard<std::mutex> guard2(m_event_mutex);
+        m_pending_events.push_back(std::move(event));
+        return;
+    }
+    process_pending_events();
+    event();
+}
+
+void Screen::post(const std::function<void()> &func) {
+    m_posted.push(func);
+    /* Only the first function posted per frame wakes up the main loop */
+    if (!m_posted_pending.exchange(true)) {
+        #if !defined(EMSCRIPTEN)
+            glfwPostEmptyEvent();
+        #endif
+    }
+}
+
+void Screen::process_pending_events() {
+    std::unique_lock<std::recursive_mutex> guard(m_ui_mutex, std::try_to_lock);
+    if (!guard.owns_lock())
+        return;
+
+    std::vector<std::function<void()>> events;
+    {
+        std::lock_guard<std::mutex> guard2(m_event_mutex);
+        events.swap(m_pending_events);
+    }
+    for (auto &event : events)
+        event();
+
+    if (!m_posted_pending.exchange(false))
+        return;
+
+    std::function<void()> func;
+    bool posted = false;
+    while (m_posted.pop(func)) {
+        try {
+            func();
+        } catch (const std::exception &e) {
+            std::cerr << "Caught exception in function posted to the screen: "
+                      << e.what() << std::endl;
+        }
+        posted = true;
+    }
+    if (posted)
+        m_redraw = true;
+}
+
+void Screen::render_thread() {
+    glfwMakeContextCurrent(m_glfw_window);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(m_render_mutex);
+            m_render_cond.wait(guard, [this] { return m_render_stop || m_redraw; });
+            if (m_render_stop)
+                break;
+        }
+
+        try {
+            draw_all();
+        } catch (const std::exception &e) {
+            std::cerr << "Caught exception in render thread: " << e.what() << std::endl;
+        }
+
+        /* Let the main thread handle events that arrived while drawing */
+        bool pending = m_posted_pending;
+        if (!pending) {
+            std::lock_guard<std::mutex> guard(m_event_mutex);
+            pending = !m_pending_events.empty();
+        }
+        if (pending)
+            glfwPostEmptyEvent();
     }
+
+    glfwMakeContextCurrent(nullptr);
+}
+
+Screen::GlyphAtlasStats Screen::glyph_atlas_stats() const {
+    std::lock_guard<std::recursive_mutex> guard(m_ui_mutex);
+    return m_glyph_atlas_stats;
+}
+
+size_t Screen::render_calls() const {
+    std::lock_guard<std::recursive_mutex> guard(m_ui_mutex);
+    return m_render_calls;
+}
+
+void Screen::prewarm_glyphs(const std::string &extra) {
+    std::lock_guard<std::recursive_mutex> guard(m_ui_mutex);
+    m_prewarm_glyphs = true;
+    m_prewarm_text += extra;
+    redraw();
 }
 
 void Screen::draw_widgets() {
     nvgBeginFrame(m_nvg_context, m_size[0], m_size[1], m_pixel_ratio);
 
+    if (m_prewarm_glyphs) {
+        m_theme->prewarm_glyphs(m_nvg_context, m_prewarm_text);
+        m_prewarm_glyphs = false;
+        m_prewarm_text.clear();
+    }
+
     draw(m_nvg_context);
 
     double elapsed = glfwGetTime() - m_last_interaction;
@@ -512,24 +882,25 @@ void Screen::draw_widgets() {
     if (elapsed > 0.5f) {
         /* Draw tooltips */
         const Widget *widget = find_widget(m_mouse_pos);
-        if (widget && !widget->tooltip().empty()) {
+        std::string tooltip = widget ? widget->tooltip() : std::string();
+        if (!tooltip.empty()) {
             int tooltip_width = 150;
 
             float bounds[4];
             nvgFontFace(m_nvg_context, "sans");
-            nvgFontSize(m_nvg_context, 15.0f);
+            nvgFontSize(m_nvg_context, m_theme->m_tooltip_font_size);
             nvgTextAlign(m_nvg_context, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
             nvgTextLineHeight(m_nvg_context, 1.1f);
             Vector2i pos = widget->absolute_position() +
                            Vector2i(widget->width() / 2, widget->height() + 10);
 
             nvgTextBounds(m_nvg_context, pos.x(), pos.y(),
-                            widget->tooltip().c_str(), nullptr, bounds);
+                            tooltip.c_str(), nullptr, bounds);
             int h = (bounds[2] - bounds[0]) / 2;
             if (h > tooltip_width / 2) {
                 nvgTextAlign(m_nvg_context, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
                 nvgTextBoxBounds(m_nvg_context, pos.x(), pos.y(), tooltip_width,
-                                widget->tooltip().c_str(), nullptr, bounds);
+                                tooltip.c_str(), nullptr, bounds);
 
                 h = (bounds[2] - bounds[0]) / 2;
             }
@@ -551,11 +922,36 @@ void Screen::draw_widgets() {
             nvgFillColor(m_nvg_context, Color(255, 255));
             nvgFontBlur(m_nvg_context, 0.0f);
             nvgTextBox(m_nvg_context, pos.x() - h, pos.y(), tooltip_width,
-                       widget->tooltip().c_str(), nullptr);
+                       tooltip.c_str(), nullptr);
         }
     }
 
     nvgEndFrame(m_nvg_context);
+
+    /* Evict cached images that have not been drawn recently if needed */
+    ImageCache::get(m_nvg_context)->next_frame();
+
+    /* Update the glyph atlas statistics */
+    RenderTracker &tracker =
+        render_tracker(nvgInternalParams(m_nvg_context)->userPtr);
+    GlyphAtlasStats &stats = m_glyph_atlas_stats;
+    stats.pages = tracker.pages.size();
+    stats.bytes = 0;
+    stats.occupancy = 0.f;
+    for (auto const &page : tracker.pages) {
+        const Vector2i &size = page.second.first;
+        stats.bytes += (size_t) size.x() * (size_t) size.y();
+        if (page.first == tracker.current_page && size.y() > 0)
+            stats.occupancy = page.second.second / (float) size.y();
+    }
+    stats.evictions = tracker.evictions;
+    stats.upload_bytes = tracker.upload_bytes;
+    stats.upload_bytes_total += tracker.upload_bytes;
+    tracker.upload_bytes = 0;
+    tracker.other_uploads.clear();
+
+    m_render_calls = tracker.render_calls;
+    tracker.render_calls = 0;
 }
 
 bool Screen::keyboard_event(int key, int scancode, int action, int modifiers) {
@@ -588,9 +984,14 @@ bool Screen::resize_event(const Vector2i& size) {
 void Screen::redraw() {
     if (!m_redraw) {
         m_redraw = true;
-        #if !defined(EMSCRIPTEN)
-            glfwPostEmptyEvent();
-        #endif
+        if (m_render_thread.joinable()) {
+            std::lock_guard<std::mutex> guard(m_render_mutex);
+            m_render_cond.notify_one();
+        } else {
+            #if !defined(EMSCRIPTEN)
+                glfwPostEmptyEvent();
+            #endif
+        }
     }
 }
 
@@ -622,7 +1023,8 @@ void Screen::cursor_pos_callback_event(double x, double y) {
             ret = mouse_motion_event(p, p - m_mouse_pos, m_mouse_state, m_modifiers);
 
         m_mouse_pos = p;
-        m_redraw |= ret;
+        if (ret)
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -633,10 +1035,10 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
     m_last_interaction = glfwGetTime();
     try {
         if (m_focus_path.size() > 1) {
-            const Window *window =
-                dynamic_cast<Window *>(m_focus_path[m_focus_path.size() - 2]);
-            if (window && window->modal()) {
-                if (!window->contains(m_mouse_pos))
+            const Widget *widget = m_focus_path[m_focus_path.size() - 2];
+            if (widget->is_window()) {
+                const Window *window = static_cast<const Window *>(widget);
+                if (window->modal() && !window->contains(m_mouse_pos))
                     return;
             }
         }
@@ -670,8 +1072,9 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
             m_drag_widget = nullptr;
         }
 
-        m_redraw |= mouse_button_event(m_mouse_pos, button,
-                                       action == GLFW_PRESS, m_modifiers);
+        if (mouse_button_event(m_mouse_pos, button,
+                               action == GLFW_PRESS, m_modifiers))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -680,7 +1083,8 @@ void Screen::mouse_button_callback_event(int button, int action, int modifiers)
 void Screen::key_callback_event(int key, int scancode, int action, int mods) {
     m_last_interaction = glfwGetTime();
     try {
-        m_redraw |= keyboard_event(key, scancode, action, mods);
+        if (keyboard_event(key, scancode, action, mods))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -689,7 +1093,8 @@ void Screen::key_callback_event(int key, int scancode, int action, int mods) {
 void Screen::char_callback_event(unsigned int codepoint) {
     m_last_interaction = glfwGetTime();
     try {
-        m_redraw |= keyboard_character_event(codepoint);
+        if (keyboard_character_event(codepoint))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -699,21 +1104,23 @@ void Screen::drop_callback_event(int count, const char **filenames) {
     std::vector<std::string> arg(count);
     for (int i = 0; i < count; ++i)
         arg[i] = filenames[i];
-    m_redraw |= drop_event(arg);
+    if (drop_event(arg))
+        m_redraw = true;
 }
 
 void Screen::scroll_callback_event(double x, double y) {
     m_last_interaction = glfwGetTime();
     try {
         if (m_focus_path.size() > 1) {
-            const Window *window =
-                dynamic_cast<Window *>(m_focus_path[m_focus_path.size() - 2]);
-            if (window && window->modal()) {
-                if (!window->contains(m_mouse_pos))
+            const Widget *widget = m_focus_path[m_focus_path.size() - 2];
+            if (widget->is_window()) {
+                const Window *window = static_cast<const Window *>(widget);
+                if (window->modal() && !window->contains(m_mouse_pos))
                     return;
             }
         }
-        m_redraw |= scroll_event(m_mouse_pos, Vector2f(x, y));
+        if (scroll_event(m_mouse_pos, Vector2f(x, y)))
+            m_redraw = true;
     } catch (const std::exception &e) {
         std::cerr << "Caught exception in event handler: " << e.what() << std::endl;
     }
@@ -732,6 +1139,10 @@ void Screen::resize_callback_event(int, int) {
 
 #if defined(_WIN32) || defined(__linux__) || defined(EMSCRIPTEN)
     m_size = Vector2i(m_size.x() / m_pixel_ratio, m_size.y() / m_pixel_ratio);
+#else
+    /* Recompute pixel ratio on OSX (needed when rendering on another thread) */
+    if (m_size[0])
+        m_pixel_ratio = (float) m_fbsize[0] / (float) m_size[0];
 #endif
 
     m_last_interaction = glfwGetTime();
@@ -754,7 +1165,7 @@ void Screen::update_focus(Widget *widget) {
     Widget *window = nullptr;
     while (widget) {
         m_focus_path.push_back(widget);
-        if (dynamic_cast<Window *>(widget))
+        if (widget->is_window())
             window = widget;
         widget = widget->parent();
     }
@@ -797,8 +1208,11 @@ void Screen::move_window_to_front(Window *window) {
                 base_index = index;
         changed = false;
         for (size_t index = 0; index < m_children.size(); ++index) {
-            Popup *pw = dynamic_cast<Popup *>(m_children[index]);
-            if (pw && pw->parent_window() == window && index < base_index) {
+            Widget *child = m_children[index];
+            if (!child->is_popup())
+                continue;
+            Popup *pw = static_cast<Popup *>(child);
+            if (pw->parent_window() == window && index < base_index) {
                 move_window_to_front(pw);
                 changed = true;
                 break;
@@ -60,4 +60,9 @@ void StackedWidget::add_child(int index, Widget *widget) {
     set_selected_index(index);
 }
 
+void StackedWidget::add_children(int index, Widget *const *widgets, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        add_child(index + (int) i, widgets[i]);
+}
+
 NAMESPACE_END(nanogui)
@@ -49,6 +49,13 @@ void TabWidget::add_child(int /*index*/, Widget * /*widget*/) {
     );
 }
 
+void TabWidget::add_children(int index, Widget *const *widgets, size_t count) {
+    if (count == 0)
+        return;
+    /* Raises the same error as add_child() */
+    add_child(index, widgets[0]);
+}
+
 void TabWidget::set_active_tab(int tab_index) {
     m_header->set_active_tab(tab_index);
     m_content->set_selected_index(tab_index);
@@ -0,0 +1,650 @@
+/*
+    src/textarea.cpp -- Multi-line text editor for large documents
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textarea.h>
+#include <nanogui/screen.h>
+#include <nanogui/opengl.h>
+#include <nanogui/theme.h>
+#include <algorithm>
+#include <cstring>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Distance between the border and the text
+static const float text_area_padding = 4.f;
+/// Width of the vertical scroll bar
+static const float text_area_scrollbar_width = 12.f;
+
+static bool is_continuation(char c) { return (c & 0xC0) == 0x80; }
+
+TextArea::TextArea(Widget *parent) : Widget(parent) {
+    set_value("");
+    set_cursor(Cursor::IBeam);
+}
+
+std::string TextArea::value() const {
+    std::string result;
+    copy(0, size(), result);
+    return result;
+}
+
+void TextArea::set_value(const std::string &value) {
+    m_text.assign(value.begin(), value.end());
+    m_text.resize(value.size() + std::max((size_t) 64, value.size() / 8));
+    m_gap_begin = value.size();
+    m_gap_end = m_text.size();
+
+    m_lines.clear();
+    m_lines.push_back(0);
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\n')
+            m_lines.push_back(i + 1);
+    }
+    m_lines_gap_begin = m_lines.size();
+    m_lines.resize(m_lines.size() + 64);
+    m_lines_gap_end = m_lines.size();
+
+    m_glyphs.clear();
+    m_cursor_pos = m_selection_pos = 0;
+    m_preferred_x = -1;
+    m_scroll_x = 0;
+    m_scroll_y = 0;
+}
+
+void TextArea::insert(const std::string &text) {
+    delete_selection();
+    insert_text(m_cursor_pos, text.data(), text.size());
+    m_cursor_pos += text.size();
+    m_selection_pos = m_cursor_pos;
+    m_scroll_to_cursor = true;
+}
+
+void TextArea::append(const std::string &text) {
+    if (m_scroll_y >= max_scroll() - 1)
+        m_scroll_to_end = true;
+    insert_text(size(), text.data(), text.size());
+}
+
+std::string TextArea::line(size_t index) const {
+    std::string result;
+    if (index < line_count())
+        copy(line_start(index), line_end(index), result);
+    return result;
+}
+
+void TextArea::set_editable(bool editable) {
+    m_editable = editable;
+    set_cursor(editable ? Cursor::IBeam : Cursor::Arrow);
+}
+
+void TextArea::set_cursor_pos(size_t pos) {
+    pos = std::min(pos, size());
+    while (pos > 0 && pos < size() && is_continuation(at(pos)))
+        --pos;
+    move_cursor(pos, false);
+    m_preferred_x = -1;
+}
+
+std::string TextArea::selection() const {
+    std::string result;
+    copy(std::min(m_cursor_pos, m_selection_pos),
+         std::max(m_cursor_pos, m_selection_pos), result);
+    return result;
+}
+
+/* ----------------------------- Text storage ------------------------------ */
+
+void TextArea::copy(size_t begin, size_t end, std::string &out) const {
+    out.clear();
+    out.reserve(end - begin);
+    if (begin < m_gap_begin)
+        out.append(m_text.data() + begin, std::min(end, m_gap_begin) - begin);
+    if (end > m_gap_begin) {
+        size_t gap = m_gap_end - m_gap_begin;
+        begin = std::max(begin, m_gap_begin);
+        out.append(m_text.data() + begin + gap, end - begin);
+    }
+}
+
+void TextArea::move_gap(size_t pos) {
+    size_t gap = m_gap_end - m_gap_begin;
+    char *data = m_text.data();
+    if (pos < m_gap_begin)
+        memmove(data + pos + gap, data + pos, m_gap_begin - pos);
+    else if (pos > m_gap_begin)
+        memmove(data + m_gap_begin, data + m_gap_end, pos - m_gap_begin);
+    m_gap_begin = pos;
+    m_gap_end = pos + gap;
+}
+
+void TextArea::insert_text(size_t pos, const char *data, size_t size) {
+    if (size == 0)
+        return;
+
+    size_t line = line_of(pos), newlines = (size_t) std::count(data, data + size, '\n');
+    /* Lines starting after 'pos' store their distance from the end, which the
+       insertion does not change */
+    move_lines_gap(line + 1);
+
+    move_gap(pos);
+    if (m_gap_end - m_gap_begin < size) {
+        size_t total = this->size(),
+               gap = std::max(size, total / 2) + 64;
+        std::vector<char> text(total + gap);
+        memcpy(text.data(), m_text.data(), m_gap_begin);
+        memcpy(text.data() + m_gap_begin + gap, m_text.data() + m_gap_end,
+               m_text.size() - m_gap_end);
+        m_text.swap(text);
+        m_gap_end = m_gap_begin + gap;
+    }
+    memcpy(m_text.data() + m_gap_begin, data, size);
+    m_gap_begin += size;
+
+    if (m_lines_gap_end - m_lines_gap_begin < newlines) {
+        size_t count = line_count(),
+               gap = std::max(newlines, count / 2) + 64;
+        std::vector<size_t> lines(count + gap);
+        std::copy(m_lines.begin(), m_lines.begin() + m_lines_gap_begin, lines.begin());
+        std::copy(m_lines.begin() + m_lines_gap_end, m_lines.end(),
+                  lines.begin() + m_lines_gap_begin + gap);
+        m_lines.swap(lines);
+        m_lines_gap_end = m_lines_gap_begin + gap;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] == '\n')
+            m_lines[m_lines_gap_begin++] = pos + i + 1;
+    }
+
+    invalidate_glyphs(line, newlines > 0);
+}
+
+void TextArea::erase_text(size_t begin, size_t end) {
+    if (begin >= end)
+        return;
+
+    size_t line = line_of(begin), total = size(), removed = 0;
+    move_lines_gap(line + 1);
+
+    /* Remove the lines whose line break is erased */
+    while (m_lines_gap_end < m_lines.size() && total - m_lines[m_lines_gap_end] <= end) {
+        m_lines_gap_end++;
+        removed++;
+    }
+
+    move_gap(begin);
+    m_gap_end += end - begin;
+
+    invalidate_glyphs(line, removed > 0);
+}
+
+size_t TextArea::next_char(size_t pos) const {
+    size_t total = size();
+    if (pos >= total)
+        return total;
+    ++pos;
+    while (pos < total && is_continuation(at(pos)))
+        ++pos;
+    return pos;
+}
+
+size_t TextArea::prev_char(size_t pos) const {
+    if (pos == 0)
+        return 0;
+    --pos;
+    while (pos > 0 && is_continuation(at(pos)))
+        --pos;
+    return pos;
+}
+
+/* ------------------------------ Line index ------------------------------- */
+
+size_t TextArea::line_start(size_t line) const {
+    if (line < m_lines_gap_begin)
+        return m_lines[line];
+    return size() - m_lines[line + (m_lines_gap_end - m_lines_gap_begin)];
+}
+
+size_t TextArea::line_end(size_t line) const {
+    return line + 1 < line_count() ? line_start(line + 1) - 1 : size();
+}
+
+size_t TextArea::line_of(size_t pos) const {
+    size_t lo = 0, hi = line_count() - 1;
+    while (lo < hi) {
+        size_t mid = (lo + hi + 1) / 2;
+        if (line_start(mid) <= pos)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+void TextArea::move_lines_gap(size_t count) {
+    size_t total = size();
+    while (m_lines_gap_begin > count) {
+        --m_lines_gap_begin;
+        --m_lines_gap_end;
+        m_lines[m_lines_gap_end] = total - m_lines[m_lines_gap_begin];
+    }
+    while (m_lines_gap_begin < count) {
+        m_lines[m_lines_gap_begin] = total - m_lines[m_lines_gap_end];
+        ++m_lines_gap_begin;
+        ++m_lines_gap_end;
+    }
+}
+
+/* ---------------------------- Caret positions ---------------------------- */
+
+const std::vector<float> &TextArea::glyphs(NVGcontext *ctx, size_t line) {
+    if (m_glyphs_font_size != font_size()) {
+        m_glyphs.clear();
+        m_glyphs_font_size = font_size();
+    }
+
+    auto it = m_glyphs.find(line);
+    if (it != m_glyphs.end())
+        return it->second;
+
+    std::string text;
+    copy(line_start(line), line_end(line), text);
+    std::vector<float> x(text.size() + 1, 0.f);
+
+    if (!text.empty()) {
+        const char *str = text.data();
+        std::vector<NVGglyphPosition> positions(text.size());
+        int count = nvgTextGlyphPositions(ctx, 0, 0, str, str + text.size(),
+                                          positions.data(), (int) positions.size());
+        /* Bytes of a multi-byte character share its position */
+        float prev = 0.f;
+        for (size_t i = 0, j = 0; i < text.size(); ++i) {
+            if (j < (size_t) count && positions[j].str == str + i)
+                prev = positions[j++].x;
+            x[i] = prev;
+        }
+        x[text.size()] = nvgTextBounds(ctx, 0, 0, str, str + text.size(), nullptr);
+    }
+
+    return m_glyphs.emplace(line, std::move(x)).first->second;
+}
+
+void TextArea::invalidate_glyphs(size_t line, bool following) {
+    if (following)
+        m_glyphs.erase(m_glyphs.lower_bound(line), m_glyphs.end());
+    else
+        m_glyphs.erase(line);
+}
+
+size_t TextArea::position_at(NVGcontext *ctx, size_t line, float x) {
+    const std::vector<float> &positions = glyphs(ctx, line);
+
+    /* Binary search for the closest caret position (the earlier one on ties) */
+    auto it = std::lower_bound(positions.begin(), positions.end(), x);
+    if (it == positions.end())
+        --it;
+    else if (it != positions.begin() && x - *(it - 1) <= *it - x)
+        --it;
+    while (it != positions.begin() && *(it - 1) == *it)
+        --it;
+
+    return line_start(line) + (size_t) (it - positions.begin());
+}
+
+size_t TextArea::position_at(const Vector2i &p) {
+    double y = p.y() - m_pos.y() - text_area_padding + m_scroll_y;
+    size_t line = (size_t) std::max(0.0, std::floor(y / line_height()));
+    line = std::min(line, line_count() - 1);
+    float x = p.x() - m_pos.x() - text_area_padding + m_scroll_x;
+
+    NVGcontext *ctx = screen()->nvg_context();
+    nvgSave(ctx);
+    set_font(ctx);
+    size_t pos = position_at(ctx, line, x);
+    nvgRestore(ctx);
+    return pos;
+}
+
+float TextArea::caret_x(NVGcontext *ctx, size_t pos) {
+    size_t line = line_of(pos);
+    return glyphs(ctx, line)[pos - line_start(line)];
+}
+
+/* ---------------------------- Editing helpers ---------------------------- */
+
+void TextArea::set_font(NVGcontext *ctx) {
+    nvgFontSize(ctx, font_size());
+    nvgFontFace(ctx, "sans");
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+}
+
+void TextArea::move_cursor(size_t pos, bool select) {
+    m_cursor_pos = pos;
+    if (!select)
+        m_selection_pos = pos;
+    m_scroll_to_cursor = true;
+}
+
+void TextArea::move_vertically(long lines, bool select) {
+    NVGcontext *ctx = screen()->nvg_context();
+    nvgSave(ctx);
+    set_font(ctx);
+    if (m_preferred_x < 0)
+        m_preferred_x = caret_x(ctx, m_cursor_pos);
+    long line = (long) line_of(m_cursor_pos) + lines;
+    line = std::max(0l, std::min(line, (long) line_count() - 1));
+    move_cursor(position_at(ctx, (size_t) line, m_preferred_x), select);
+    nvgRestore(ctx);
+}
+
+bool TextArea::delete_selection() {
+    if (m_cursor_pos == m_selection_pos)
+        return false;
+    size_t begin = std::min(m_cursor_pos, m_selection_pos),
+           end = std::max(m_cursor_pos, m_selection_pos);
+    erase_text(begin, end);
+    m_cursor_pos = m_selection_pos = begin;
+    return true;
+}
+
+void TextArea::changed() {
+    m_scroll_to_cursor = true;
+    m_preferred_x = -1;
+    if (m_callback)
+        m_callback();
+}
+
+int TextArea::visible_lines() const {
+    return std::max(1, (int) ((m_size.y() - 2 * text_area_padding) / line_height()));
+}
+
+double TextArea::max_scroll() const {
+    return std::max(0.0, line_count() * (double) line_height() -
+                         (m_size.y() - 2 * text_area_padding));
+}
+
+float TextArea::scrollbar_size() const {
+    double content = line_count() * (double) line_height() + 2 * text_area_padding;
+    return std::max(16.f, m_size.y() * (float) std::min(1.0, m_size.y() / content));
+}
+
+/* -------------------------------- Events --------------------------------- */
+
+Vector2i TextArea::preferred_size(NVGcontext *) const {
+    return Vector2i((int) (font_size() * 25),
+                    (int) (line_height() * 10 + 2 * text_area_padding));
+}
+
+bool TextArea::mouse_button_event(const Vector2i &p, int button, bool down,
+                                  int modifiers) {
+    if (button != GLFW_MOUSE_BUTTON_1)
+        return Widget::mouse_button_event(p, button, down, modifiers);
+
+    m_drag_scrollbar = false;
+    if (!down)
+        return true;
+    if (!m_focused)
+        request_focus();
+
+    if (max_scroll() > 0 &&
+        p.x() >= m_pos.x() + m_size.x() - text_area_scrollbar_width) {
+        m_drag_scrollbar = true;
+        return true;
+    }
+
+    move_cursor(position_at(p), modifiers & GLFW_MOD_SHIFT);
+    m_preferred_x = -1;
+    return true;
+}
+
+bool TextArea::mouse_drag_event(const Vector2i &p, const Vector2i &rel,
+                                int /* button */, int /* modifiers */) {
+    if (m_drag_scrollbar) {
+        double max_scroll = this->max_scroll();
+        m_scroll_y = std::max(0.0, std::min(max_scroll, m_scroll_y + rel.y() * max_scroll /
+                                            (m_size.y() - 8 - scrollbar_size())));
+    } else {
+        move_cursor(position_at(p), true);
+        m_preferred_x = -1;
+    }
+    return true;
+}
+
+bool TextArea::scroll_event(const Vector2i & /* p */, const Vector2f &rel) {
+    float amount = line_height() * 3;
+    m_scroll_y = std::max(0.0, std::min(max_scroll(), m_scroll_y - rel.y() * amount));
+    m_scroll_x = std::max(0.f, m_scroll_x - rel.x() * amount);
+    return true;
+}
+
+bool TextArea::focus_event(bool focused) {
+    Widget::focus_event(focused);
+    return true;
+}
+
+bool TextArea::keyboard_event(int key, int /* scancode */, int action, int modifiers) {
+    if (!focused() || (action != GLFW_PRESS && action != GLFW_REPEAT))
+        return false;
+
+    bool shift = modifiers & GLFW_MOD_SHIFT,
+         command = modifiers & SYSTEM_COMMAND_MOD;
+    Screen *sc = screen();
+
+    switch (key) {
+        case GLFW_KEY_UP:        move_vertically(-1, shift); return true;
+        case GLFW_KEY_DOWN:      move_vertically(1, shift); return true;
+        case GLFW_KEY_PAGE_UP:   move_vertically(-visible_lines(), shift); return true;
+        case GLFW_KEY_PAGE_DOWN: move_vertically(visible_lines(), shift); return true;
+        default: break;
+    }
+
+    m_preferred_x = -1;
+    if (key == GLFW_KEY_LEFT) {
+        move_cursor(prev_char(m_cursor_pos), shift);
+    } else if (key == GLFW_KEY_RIGHT) {
+        move_cursor(next_char(m_cursor_pos), shift);
+    } else if (key == GLFW_KEY_HOME) {
+        move_cursor(command ? 0 : line_start(line_of(m_cursor_pos)), shift);
+    } else if (key == GLFW_KEY_END) {
+        move_cursor(command ? size() : line_end(line_of(m_cursor_pos)), shift);
+    } else if (key == GLFW_KEY_A && command) {
+        m_selection_pos = 0;
+        move_cursor(size(), true);
+    } else if (key == GLFW_KEY_C && command) {
+        if (sc && m_cursor_pos != m_selection_pos)
+            glfwSetClipboardString(sc->glfw_window(), selection().c_str());
+    } else if (!m_editable) {
+        return true;
+    } else if (key == GLFW_KEY_BACKSPACE) {
+        if (!delete_selection() && m_cursor_pos > 0) {
+            size_t pos = prev_char(m_cursor_pos);
+            erase_text(pos, m_cursor_pos);
+            m_cursor_pos = m_selection_pos = pos;
+        }
+        changed();
+    } else if (key == GLFW_KEY_DELETE) {
+        if (!delete_selection())
+            erase_text(m_cursor_pos, next_char(m_cursor_pos));
+        changed();
+    } else if (key == GLFW_KEY_ENTER || key == GLFW_KEY_KP_ENTER) {
+        insert("\n");
+        changed();
+    } else if (key == GLFW_KEY_X && command) {
+        if (sc && m_cursor_pos != m_selection_pos) {
+            glfwSetClipboardString(sc->glfw_window(), selection().c_str());
+            delete_selection();
+            changed();
+        }
+    } else if (key == GLFW_KEY_V && command) {
+        const char *str = sc ? glfwGetClipboardString(sc->glfw_window()) : nullptr;
+        if (str) {
+            insert(str);
+            changed();
+        }
+    }
+
+    return true;
+}
+
+bool TextArea::keyboard_character_event(unsigned int codepoint) {
+    if (!m_editable || !focused())
+        return false;
+    insert(utf8((int) codepoint).data());
+    changed();
+    return true;
+}
+
+/* -------------------------------- Drawing -------------------------------- */
+
+void TextArea::draw(NVGcontext *ctx) {
+    Widget::draw(ctx);
+
+    NVGpaint bg = nvgBoxGradient(ctx,
+        m_pos.x() + 1, m_pos.y() + 1 + 1.0f, m_size.x() - 2, m_size.y() - 2,
+        3, 4, Color(255, 32), Color(32, 32));
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, m_pos.x() + 1, m_pos.y() + 1 + 1.0f, m_size.x() - 2,
+                   m_size.y() - 2, 3);
+    nvgFillPaint(ctx, bg);
+    nvgFill(ctx);
+
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, m_pos.x() + 0.5f, m_pos.y() + 0.5f, m_size.x() - 1,
+                   m_size.y() - 1, 2.5f);
+    nvgStrokeColor(ctx, Color(0, 48));
+    nvgStroke(ctx);
+
+    float lh = line_height();
+    double max_scroll = this->max_scroll();
+    bool scrollbar = max_scroll > 0;
+    float view_x = m_pos.x() + text_area_padding,
+          view_y = m_pos.y() + text_area_padding,
+          view_w = m_size.x() - 2 * text_area_padding -
+                   (scrollbar ? text_area_scrollbar_width : 0.f),
+          view_h = m_size.y() - 2 * text_area_padding;
+
+    nvgSave(ctx);
+    set_font(ctx);
+
+    size_t cursor_line = line_of(m_cursor_pos);
+    if (m_scroll_to_end) {
+        m_scroll_y = max_scroll;
+        m_scroll_to_end = false;
+    }
+    if (m_scroll_to_cursor) {
+        double y = cursor_line * (double) lh;
+        if (y < m_scroll_y)
+            m_scroll_y = y;
+        else if (y + lh > m_scroll_y + view_h)
+            m_scroll_y = y + lh - view_h;
+        float x = caret_x(ctx, m_cursor_pos);
+        if (x < m_scroll_x)
+            m_scroll_x = x;
+        else if (x + 2 > m_scroll_x + view_w)
+            m_scroll_x = x + 2 - view_w;
+        m_scroll_to_cursor = false;
+    }
+    m_scroll_y = std::max(0.0, std::min(max_scroll, m_scroll_y));
+    m_scroll_x = std::max(0.f, m_scroll_x);
+
+    nvgIntersectScissor(ctx, view_x - 1, view_y, view_w + 2, view_h);
+
+    size_t first = (size_t) (m_scroll_y / lh),
+           last = std::min(line_count(), (size_t) std::ceil((m_scroll_y + view_h) / lh));
+    size_t sel_begin = std::min(m_cursor_pos, m_selection_pos),
+           sel_end = std::max(m_cursor_pos, m_selection_pos);
+    float x0 = view_x - m_scroll_x;
+    std::string text;
+
+    nvgFillColor(ctx, Color(255, 80));
+    for (size_t line = first; line < last; ++line) {
+        size_t start = line_start(line), end = line_end(line);
+        if (sel_begin == sel_end || sel_begin > end || sel_end <= start)
+            continue;
+        const std::vector<float> &x = glyphs(ctx, line);
+        float y = view_y + (float) (line * (double) lh - m_scroll_y),
+              sx = x0 + x[std::max(sel_begin, start) - start],
+              ex = x0 + x[std::min(sel_end, end) - start];
+        if (sel_end > end)
+            ex += lh * 0.3f; /* The line break is selected as well */
+        nvgBeginPath(ctx);
+        nvgRect(ctx, sx, y, ex - sx, lh);
+        nvgFill(ctx);
+    }
+
+    nvgFillColor(ctx, m_enabled ? m_theme->m_text_color : m_theme->m_disabled_text_color);
+    for (size_t line = first; line < last; ++line) {
+        size_t start = line_start(line), end = line_end(line);
+        const std::vector<float> &x = glyphs(ctx, line);
+        float y = view_y + (float) ((line + 0.5) * lh - m_scroll_y);
+
+        /* Only draw the horizontally visible part of long lines */
+        size_t b = (size_t) (std::upper_bound(x.begin(), x.end(), m_scroll_x) - x.begin()),
+               e = (size_t) (std::lower_bound(x.begin(), x.end(), m_scroll_x + view_w) - x.begin());
+        b = b > 0 ? b - 1 : 0;
+        e = std::min(e + 1, end - start);
+        while (b > 0 && is_continuation(at(start + b)))
+            --b;
+        while (e < end - start && is_continuation(at(start + e)))
+            ++e;
+        if (b >= e)
+            continue;
+
+        copy(start + b, start + e, text);
+        nvgText(ctx, x0 + x[b], y, text.data(), text.data() + text.size());
+    }
+
+    if (m_editable && focused() && cursor_line >= first && cursor_line < last) {
+        float cx = x0 + caret_x(ctx, m_cursor_pos),
+              y = view_y + (float) (cursor_line * (double) lh - m_scroll_y);
+        nvgBeginPath(ctx);
+        nvgMoveTo(ctx, cx, y);
+        nvgLineTo(ctx, cx, y + lh);
+        nvgStrokeColor(ctx, nvgRGBA(255, 192, 0, 255));
+        nvgStrokeWidth(ctx, 1.0f);
+        nvgStroke(ctx);
+    }
+    nvgRestore(ctx);
+
+    /* Only keep the caret positions of visible lines */
+    for (auto it = m_glyphs.begin(); it != m_glyphs.end(); ) {
+        if ((it->first < first || it->first >= last) && it->first != cursor_line)
+            it = m_glyphs.erase(it);
+        else
+            ++it;
+    }
+
+    if (!scrollbar)
+        return;
+
+    float scrollh = scrollbar_size(),
+          scroll = (float) (m_scroll_y / max_scroll);
+    NVGpaint paint = nvgBoxGradient(
+        ctx, m_pos.x() + m_size.x() - 12 + 1, m_pos.y() + 4 + 1, 8,
+        m_size.y() - 8, 3, 4, Color(0, 32), Color(0, 92));
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, m_pos.x() + m_size.x() - 12, m_pos.y() + 4, 8,
+                   m_size.y() - 8, 3);
+    nvgFillPaint(ctx, paint);
+    nvgFill(ctx);
+
+    paint = nvgBoxGradient(
+        ctx, m_pos.x() + m_size.x() - 12 - 1,
+        m_pos.y() + 4 + (m_size.y() - 8 - scrollh) * scroll - 1, 8, scrollh,
+        3, 4, Color(220, 100), Color(128, 100));
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, m_pos.x() + m_size.x() - 12 + 1,
+                   m_pos.y() + 4 + 1 + (m_size.y() - 8 - scrollh) * scroll, 8 - 2,
+                   scrollh - 2, 2);
+    nvgFillPaint(ctx, paint);
+    nvgFill(ctx);
+}
+
+NAMESPACE_END(nanogui)
@@ -18,6 +18,9 @@
 #include <nanogui/opengl.h>
 #include <nanogui/theme.h>
 #include <regex>
+#include <unordered_map>
+#include <mutex>
+#include <cstring>
 #include <iostream>
 
 NAMESPACE_BEGIN(nanogui)
@@ -178,20 +181,22 @@ void TextBox::draw(NVGcontext* ctx) {
         nvgFontFace(ctx, "sans");
     }
 
+    int align = NVG_ALIGN_MIDDLE;
     switch (m_alignment) {
         case Alignment::Left:
-            nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+            align |= NVG_ALIGN_LEFT;
             draw_pos.x() += x_spacing + spin_arrows_width;
             break;
         case Alignment::Right:
-            nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE);
+            align |= NVG_ALIGN_RIGHT;
             draw_pos.x() += m_size.x() - unit_width - x_spacing;
             break;
         case Alignment::Center:
-            nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+            align |= NVG_ALIGN_CENTER;
             draw_pos.x() += m_size.x() * 0.5f;
             break;
     }
+    nvgTextAlign(ctx, align);
 
     nvgFontSize(ctx, font_size());
     nvgFillColor(ctx, m_enabled && (!m_committed || !m_value.empty()) ?
@@ -213,24 +218,30 @@ void TextBox::draw(NVGcontext* ctx) {
     if (m_committed) {
         nvgText(ctx, draw_pos.x(), draw_pos.y(), m_value.empty() ? m_placeholder.c_str() : m_value.c_str(), nullptr);
     } else {
-        const int max_glyphs = 1024;
-        NVGglyphPosition glyphs[max_glyphs];
-        float text_bound[4];
-        nvgTextBounds(ctx, draw_pos.x(), draw_pos.y(), m_value_temp.c_str(),
-                      nullptr, text_bound);
-        float lineh = text_bound[3] - text_bound[1];
+        /* Caret positions are cached and only remeasured where the text changed */
+        nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+        update_glyphs(ctx);
+        nvgTextAlign(ctx, align);
+
+        float advance = m_glyph_x.back(), lineh = m_line_height;
+        auto text_start = [&]() {
+            switch (m_alignment) {
+                case Alignment::Right: return draw_pos.x() - advance;
+                case Alignment::Center: return draw_pos.x() - advance * 0.5f;
+                default: return (float) draw_pos.x();
+            }
+        };
 
         // find cursor positions
-        int nglyphs =
-            nvgTextGlyphPositions(ctx, draw_pos.x(), draw_pos.y(),
-                                  m_value_temp.c_str(), nullptr, glyphs, max_glyphs);
-        update_cursor(ctx, text_bound[2], glyphs, nglyphs);
+        float offset = text_start();
+        update_cursor(offset);
 
         // compute text offset
+        int nbytes = (int) m_value_temp.size();
         int prev_cpos = m_cursor_pos > 0 ? m_cursor_pos - 1 : 0;
-        int next_cpos = m_cursor_pos < nglyphs ? m_cursor_pos + 1 : nglyphs;
-        float prev_cx = cursor_index2Position(prev_cpos, text_bound[2], glyphs, nglyphs);
-        float next_cx = cursor_index2Position(next_cpos, text_bound[2], glyphs, nglyphs);
+        int next_cpos = m_cursor_pos < nbytes ? m_cursor_pos + 1 : nbytes;
+        float prev_cx = cursor_index2Position(prev_cpos, offset);
+        float next_cx = cursor_index2Position(next_cpos, offset);
 
         if (next_cx > clip_x + clip_width)
             m_text_offset -= next_cx - (clip_x + clip_width) + 1;
@@ -238,22 +249,15 @@ void TextBox::draw(NVGcontext* ctx) {
             m_text_offset += clip_x - prev_cx + 1;
 
         draw_pos.x() = old_draw_pos.x() + m_text_offset;
+        offset = text_start();
 
         // draw text with offset
         nvgText(ctx, draw_pos.x(), draw_pos.y(), m_value_temp.c_str(), nullptr);
-        nvgTextBounds(ctx, draw_pos.x(), draw_pos.y(), m_value_temp.c_str(),
-                      nullptr, text_bound);
-
-        // recompute cursor positions
-        nglyphs = nvgTextGlyphPositions(ctx, draw_pos.x(), draw_pos.y(),
-                m_value_temp.c_str(), nullptr, glyphs, max_glyphs);
 
         if (m_cursor_pos > -1) {
             if (m_selection_pos > -1) {
-                float caretx = cursor_index2Position(m_cursor_pos, text_bound[2],
-                                                    glyphs, nglyphs);
-                float selx = cursor_index2Position(m_selection_pos, text_bound[2],
-                                                  glyphs, nglyphs);
+                float caretx = cursor_index2Position(m_cursor_pos, offset);
+                float selx = cursor_index2Position(m_selection_pos, offset);
 
                 if (caretx > selx)
                     std::swap(caretx, selx);
@@ -266,7 +270,7 @@ void TextBox::draw(NVGcontext* ctx) {
                 nvgFill(ctx);
             }
 
-            float caretx = cursor_index2Position(m_cursor_pos, text_bound[2], glyphs, nglyphs);
+            float caretx = cursor_index2Position(m_cursor_pos, offset);
 
             // draw cursor
             nvgBeginPath(ctx);
@@ -374,6 +378,7 @@ bool TextBox::focus_event(bool focused) {
     if (m_editable) {
         if (focused) {
             m_value_temp = m_value;
+            m_glyph_x.clear();
             m_committed = false;
             m_cursor_pos = 0;
         } else {
@@ -446,12 +451,15 @@ bool TextBox::keyboard_event(int key, int /* scancode */, int action, int modifi
                     if (m_cursor_pos > 0) {
                         m_value_temp.erase(m_value_temp.begin() + m_cursor_pos - 1);
                         m_cursor_pos--;
+                        edit_glyphs(m_cursor_pos, 1, 0);
                     }
                 }
             } else if (key == GLFW_KEY_DELETE) {
                 if (!delete_selection()) {
-                    if (m_cursor_pos < (int) m_value_temp.length())
+                    if (m_cursor_pos < (int) m_value_temp.length()) {
                         m_value_temp.erase(m_value_temp.begin() + m_cursor_pos);
+                        edit_glyphs(m_cursor_pos, 1, 0);
+                    }
                 }
             } else if (key == GLFW_KEY_ENTER) {
                 if (!m_committed)
@@ -486,6 +494,7 @@ bool TextBox::keyboard_character_event(unsigned int codepoint) {
 
         delete_selection();
         m_value_temp.insert(m_cursor_pos, convert.str());
+        edit_glyphs(m_cursor_pos, 0, convert.str().size());
         m_cursor_pos++;
 
         m_valid_format = (m_value_temp == "") || check_format(m_value_temp, m_format);
@@ -496,27 +505,114 @@ bool TextBox::keyboard_character_event(unsigned int codepoint) {
     return false;
 }
 
-bool TextBox::check_format(const std::string &input, const std::string &format) {
+static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+/// Matches "[0-9]*" (the format of unsigned IntBox instances)
+static bool match_unsigned(const std::string &input) {
+    for (char c : input) {
+        if (!is_digit(c))
+            return false;
+    }
+    return true;
+}
+
+/// Matches "[-]?[0-9]*" (the format of signed IntBox instances)
+static bool match_signed(const std::string &input) {
+    size_t i = !input.empty() && input[0] == '-' ? 1 : 0;
+    for (; i < input.size(); ++i) {
+        if (!is_digit(input[i]))
+            return false;
+    }
+    return true;
+}
+
+/// Matches "[-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?" (the format of FloatBox instances)
+static bool match_float(const std::string &input) {
+    const char *p = input.c_str(), *end = p + input.size();
+    auto digits = [&p, end] {
+        const char *start = p;
+        while (p != end && is_digit(*p))
+            ++p;
+        return p - start;
+    };
+
+    if (p != end && (*p == '-' || *p == '+'))
+        ++p;
+    size_t integral = digits();
+    if (p != end && *p == '.') {
+        ++p;
+        if (digits() == 0)
+            return false;
+    } else if (integral == 0) {
+        return false;
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        if (p != end && (*p == '-' || *p == '+'))
+            ++p;
+        if (digits() == 0)
+            return false;
+    }
+    return p == end;
+}
+
+static std::unordered_map<std::string, std::shared_ptr<const std::regex>> format_cache;
+static std::mutex format_cache_mutex;
+
+/// Turn a format into a validator (empty if any value is valid)
+static std::function<bool(const std::string &)> compile_format(const std::string &format) {
     if (format.empty())
-        return true;
-    try {
-        std::regex regex(format);
-        return regex_match(input, regex);
-    } catch (const std::regex_error &) {
+        return nullptr;
+    else if (format == "[0-9]*")
+        return match_unsigned;
+    else if (format == "[-]?[0-9]*")
+        return match_signed;
+    else if (format == "[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?")
+        return match_float;
+
+    std::shared_ptr<const std::regex> regex;
+    {
+        std::lock_guard<std::mutex> guard(format_cache_mutex);
+        auto it = format_cache.find(format);
+        if (it != format_cache.end())
+            regex = it->second;
+    }
+
+    if (!regex) {
+        try {
+            regex = std::make_shared<const std::regex>(format, std::regex::optimize);
+        } catch (const std::regex_error &) {
 #if __GNUC__ < 4 || (__GNUC__ == 4 && __GNUC_MINOR__ < 9)
-        std::cerr << "Warning: cannot validate text field due to lacking regular expression support. please compile with GCC >= 4.9" << std::endl;
-        return true;
+            std::cerr << "Warning: cannot validate text field due to lacking regular expression support. please compile with GCC >= 4.9" << std::endl;
+            return nullptr;
 #else
-        throw;
+            throw;
 #endif
+        }
+        std::lock_guard<std::mutex> guard(format_cache_mutex);
+        regex = format_cache.emplace(format, regex).first->second;
     }
+
+    return [regex](const std::string &input) { return std::regex_match(input, *regex); };
+}
+
+void TextBox::set_format(const std::string &format) {
+    if (format == m_format && (format.empty() || m_format_validator))
+        return;
+    m_format_validator = compile_format(format);
+    m_format = format;
+}
+
+bool TextBox::check_format(const std::string &input, const std::string &format) {
+    if (format == m_format)
+        return !m_format_validator || m_format_validator(input);
+    auto validator = compile_format(format);
+    return !validator || validator(input);
 }
 
 bool TextBox::copy_selection() {
     if (m_selection_pos > -1) {
-        Screen *sc = dynamic_cast<Screen *>(this->window()->parent());
-        if (!sc)
-            return false;
+        Screen *sc = screen();
 
         int begin = m_cursor_pos;
         int end = m_selection_pos;
@@ -533,12 +629,12 @@ bool TextBox::copy_selection() {
 }
 
 void TextBox::paste_from_clipboard() {
-    Screen *sc = dynamic_cast<Screen *>(this->window()->parent());
-    if (sc)
-        return;
+    Screen *sc = screen();
     const char* cbstr = glfwGetClipboardString(sc->glfw_window());
-    if (cbstr)
+    if (cbstr) {
         m_value_temp.insert(m_cursor_pos, std::string(cbstr));
+        edit_glyphs(m_cursor_pos, 0, strlen(cbstr));
+    }
 }
 
 bool TextBox::delete_selection() {
@@ -555,6 +651,7 @@ bool TextBox::delete_selection() {
             m_value_temp.erase(m_value_temp.begin() + begin,
                              m_value_temp.begin() + end);
 
+        edit_glyphs(begin, end - begin, 0);
         m_cursor_pos = begin;
         m_selection_pos = -1;
         return true;
@@ -563,8 +660,7 @@ bool TextBox::delete_selection() {
     return false;
 }
 
-void TextBox::update_cursor(NVGcontext *, float lastx,
-                           const NVGglyphPosition *glyphs, int size) {
+void TextBox::update_cursor(float offset) {
     // handle mouse cursor events
     if (m_mouse_down_pos.x() != -1) {
         if (m_mouse_down_modifier == GLFW_MOD_SHIFT) {
@@ -573,51 +669,143 @@ void TextBox::update_cursor(NVGcontext *, float lastx,
         } else
             m_selection_pos = -1;
 
-        m_cursor_pos =
-            position2Cursor_index(m_mouse_down_pos.x(), lastx, glyphs, size);
+        m_cursor_pos = position2Cursor_index(m_mouse_down_pos.x(), offset);
 
         m_mouse_down_pos = Vector2i(-1, -1);
     } else if (m_mouse_drag_pos.x() != -1) {
         if (m_selection_pos == -1)
             m_selection_pos = m_cursor_pos;
 
-        m_cursor_pos =
-            position2Cursor_index(m_mouse_drag_pos.x(), lastx, glyphs, size);
+        m_cursor_pos = position2Cursor_index(m_mouse_drag_pos.x(), offset);
     } else {
         // set cursor to last character
         if (m_cursor_pos == -2)
-            m_cursor_pos = size;
+            m_cursor_pos = (int) m_value_temp.size();
     }
 
     if (m_cursor_pos == m_selection_pos)
         m_selection_pos = -1;
 }
 
-float TextBox::cursor_index2Position(int index, float lastx,
-                                    const NVGglyphPosition *glyphs, int size) {
-    float pos = 0;
-    if (index == size)
-        pos = lastx; // last character
-    else
-        pos = glyphs[index].x;
+float TextBox::cursor_index2Position(int index, float offset) const {
+    if (m_glyph_x.empty())
+        return offset;
+    index = std::max(0, std::min(index, (int) m_glyph_x.size() - 1));
+    return offset + m_glyph_x[index];
+}
+
+int TextBox::position2Cursor_index(float posx, float offset) const {
+    if (m_glyph_x.empty())
+        return 0;
+
+    /* Binary search for the closest caret position (the earlier one on ties) */
+    float x = posx - offset;
+    auto it = std::lower_bound(m_glyph_x.begin(), m_glyph_x.end(), x);
+    if (it == m_glyph_x.end())
+        --it;
+    else if (it != m_glyph_x.begin() && x - *(it - 1) <= *it - x)
+        --it;
 
-    return pos;
+    /* Bytes of a multi-byte character share its position: move to the first one */
+    while (it != m_glyph_x.begin() && *(it - 1) == *it)
+        --it;
+
+    return (int) (it - m_glyph_x.begin());
 }
 
-int TextBox::position2Cursor_index(float posx, float lastx,
-                                  const NVGglyphPosition *glyphs, int size) {
-    int m_cursor_id = 0;
-    float caretx = glyphs[m_cursor_id].x;
-    for (int j = 1; j < size; j++) {
-        if (std::abs(caretx - posx) > std::abs(glyphs[j].x - posx)) {
-            m_cursor_id = j;
-            caretx = glyphs[m_cursor_id].x;
-        }
+void TextBox::edit_glyphs(size_t pos, size_t removed, size_t inserted) {
+    size_t size = m_value_temp.size();
+    if (m_glyph_x.size() != size + removed - inserted + 1) {
+        m_glyph_x.clear(); /* Not measured yet */
+        return;
+    }
+
+    m_glyph_x.erase(m_glyph_x.begin() + pos + 1, m_glyph_x.begin() + pos + 1 + removed);
+    m_glyph_x.insert(m_glyph_x.begin() + pos + 1, inserted, 0.f);
+
+    /* The kerning between the last replaced character and its successor
+       changes the position after the successor as well */
+    size_t first = pos + 1, last = pos + inserted + 1;
+    if (m_glyph_dirty_first <= m_glyph_dirty_last) {
+        auto adjust = [&](size_t i) {
+            if (i <= pos)
+                return i;
+            else if (i > pos + removed)
+                return i + inserted - removed;
+            else
+                return pos + inserted + 1;
+        };
+        first = std::min(first, adjust(m_glyph_dirty_first));
+        last = std::max(last, adjust(m_glyph_dirty_last));
+    }
+    m_glyph_dirty_first = first;
+    m_glyph_dirty_last = std::min(last, size);
+}
+
+void TextBox::update_glyphs(NVGcontext *ctx) {
+    size_t size = m_value_temp.size();
+    if (m_glyph_x.size() != size + 1 || m_glyph_font_size != font_size()) {
+        m_glyph_x.assign(size + 1, 0.f);
+        m_glyph_font_size = font_size();
+        m_glyph_dirty_first = 0;
+        m_glyph_dirty_last = size;
+
+        float bounds[4];
+        nvgTextBounds(ctx, 0, 0, "", nullptr, bounds);
+        m_line_height = bounds[3] - bounds[1];
+    }
+
+    if (m_glyph_dirty_first > m_glyph_dirty_last)
+        return;
+
+    const char *str = m_value_temp.c_str();
+    auto glyph_start = [str](size_t i) {
+        while (i > 0 && (str[i] & 0xC0) == 0x80)
+            --i;
+        return i;
+    };
+
+    /* Measure from two characters before the modified range: the position
+       of the first one ('anchor') is still valid, and the second one
+       provides the kerning in front of it */
+    size_t first = m_glyph_dirty_first, last = m_glyph_dirty_last,
+           anchor = first > 0 ? glyph_start(first - 1) : 0,
+           start = anchor > 0 ? glyph_start(anchor - 1) : 0,
+           end = last;
+    /* .. up to the next character, whose position only shifted */
+    if (end < size) {
+        end++;
+        while (end < size && (str[end] & 0xC0) == 0x80)
+            end++;
+    }
+
+    size_t length = end - start;
+    std::vector<NVGglyphPosition> glyphs(length);
+    int count = length > 0 ? nvgTextGlyphPositions(ctx, 0, 0, str + start, str + end,
+                                                   glyphs.data(), (int) length) : 0;
+
+    std::vector<float> x(length + 1);
+    float prev = 0.f;
+    for (size_t i = 0, j = 0; i < length; ++i) {
+        if (j < (size_t) count && glyphs[j].str == str + start + i)
+            prev = glyphs[j++].x;
+        x[i] = prev;
+    }
+    x[length] = length > 0 ? nvgTextBounds(ctx, 0, 0, str + start, str + end, nullptr) : 0.f;
+
+    float shift = m_glyph_x[anchor] - x[anchor - start],
+          old_end = m_glyph_x[end];
+    for (size_t i = anchor + 1; i <= end; ++i)
+        m_glyph_x[i] = x[i - start] + shift;
+
+    if (end > last) {
+        float delta = m_glyph_x[end] - old_end;
+        for (size_t i = end + 1; i <= size; ++i)
+            m_glyph_x[i] += delta;
     }
-    if (std::abs(caretx - posx) > std::abs(lastx - posx))
-        m_cursor_id = size;
 
-    return m_cursor_id;
+    m_glyph_dirty_first = 1;
+    m_glyph_dirty_last = 0;
 }
 
 TextBox::SpinArea TextBox::spin_area(const Vector2i & pos) {
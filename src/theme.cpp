@@ -22,6 +22,9 @@ Theme::Theme(NVGcontext *ctx) {
     m_standard_font_size                 = 16;
     m_button_font_size                   = 20;
     m_text_box_font_size                 = 20;
+    m_tooltip_font_size                  = 15;
+    m_window_title_font_size             = 18;
+    m_window_title_shadow_blur           = 2.f;
     m_icon_scale                         = 0.77f;
 
     m_window_corner_radius               = 2;
@@ -80,6 +83,9 @@ Theme::Theme(NVGcontext *ctx) {
     m_text_box_up_icon                  = ENTYPO_ICON_CHEVRON_UP;
     m_text_box_down_icon                = ENTYPO_ICON_CHEVRON_DOWN;
 
+    /* Decompress the embedded fonts if needed (no-op unless NANOGUI_COMPRESS_RESOURCES) */
+    nanogui_resources_load();
+
     m_font_normal = nvgCreateFontMem(ctx, "sans", roboto_regular_ttf,
                                      roboto_regular_ttf_size, 0);
     m_font_bold = nvgCreateFontMem(ctx, "sans-bold", roboto_bold_ttf,
@@ -91,4 +97,56 @@ Theme::Theme(NVGcontext *ctx) {
         throw std::runtime_error("Could not load fonts!");
 }
 
+void Theme::prewarm_glyphs(NVGcontext *ctx, const std::string &extra) const {
+    std::string text;
+    for (char c = 0x20; c < 0x7F; ++c)
+        text += c;
+    text += extra;
+
+    /* Faces, sizes, and blur radii used by the built-in widgets */
+    struct Style { int font; float size, blur; };
+    const Style text_styles[] = {
+        { m_font_normal, (float) m_standard_font_size, 0.f },     /* Label, CheckBox, .. */
+        { m_font_normal, (float) m_text_box_font_size, 0.f },     /* TextBox */
+        { m_font_normal, (float) m_tooltip_font_size, 0.f },      /* Tooltips */
+        { m_font_bold, (float) m_button_font_size, 0.f },         /* Button */
+        { m_font_bold, (float) m_window_title_font_size, 0.f },   /* Window title */
+        { m_font_bold, (float) m_window_title_font_size,          /* Window title shadow */
+          m_window_title_shadow_blur }
+    };
+
+    std::string icons;
+    for (int icon : { m_check_box_icon, m_message_information_icon,
+                      m_message_question_icon, m_message_warning_icon,
+                      m_message_alt_button_icon, m_message_primary_button_icon,
+                      m_popup_chevron_right_icon, m_popup_chevron_left_icon,
+                      m_tab_header_left_icon, m_tab_header_right_icon,
+                      m_text_box_up_icon, m_text_box_down_icon })
+        icons += utf8(icon).data();
+
+    const float icon_sizes[] = {
+        m_standard_font_size * m_icon_scale,
+        m_button_font_size * m_icon_scale,
+        m_text_box_font_size * m_icon_scale
+    };
+
+    nvgSave(ctx);
+    /* Glyphs are rasterized on the CPU before drawing, so a transparent fill suffices */
+    nvgFillColor(ctx, Color(0, 0));
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    for (const Style &style : text_styles) {
+        nvgFontFaceId(ctx, style.font);
+        nvgFontSize(ctx, style.size);
+        nvgFontBlur(ctx, style.blur);
+        nvgText(ctx, 0, 0, text.c_str(), nullptr);
+    }
+    nvgFontFaceId(ctx, m_font_icons);
+    nvgFontBlur(ctx, 0.f);
+    for (float size : icon_sizes) {
+        nvgFontSize(ctx, size);
+        nvgText(ctx, 0, 0, icons.c_str(), nullptr);
+    }
+    nvgRestore(ctx);
+}
+
 NAMESPACE_END(nanogui)
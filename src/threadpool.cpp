@@ -0,0 +1,181 @@
+/*
+    src/threadpool.cpp -- Work-stealing thread pool for background tasks
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/threadpool.h>
+#include <algorithm>
+
+NAMESPACE_BEGIN(nanogui)
+
+static ref<ThreadPool> thread_pool;
+static std::mutex thread_pool_mutex;
+
+/* Identify the pool and queue of the current worker thread (if any) */
+static thread_local ThreadPool *current_pool = nullptr;
+static thread_local size_t current_index = 0;
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < thread_count; ++i)
+        m_workers.emplace_back(new Worker());
+    for (size_t i = 0; i < thread_count; ++i)
+        m_workers[i]->thread = std::thread([this, i] { run(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_all();
+    for (auto &worker : m_workers)
+        worker->thread.join();
+}
+
+ThreadPool *ThreadPool::get() {
+    std::lock_guard<std::mutex> guard(thread_pool_mutex);
+    if (!thread_pool)
+        thread_pool = new ThreadPool();
+    return thread_pool.get();
+}
+
+void ThreadPool::release() {
+    ref<ThreadPool> pool;
+    {
+        std::lock_guard<std::mutex> guard(thread_pool_mutex);
+        pool = thread_pool;
+        thread_pool = nullptr;
+    }
+    /* The pool finishes its tasks and joins the workers once 'pool' goes out of scope */
+}
+
+void ThreadPool::enqueue(Task &&task) {
+    /* Workers keep the tasks they create; other threads distribute them in turn */
+    size_t index = current_pool == this ? current_index
+                                        : m_next++ % m_workers.size();
+    Worker &worker = *m_workers[index];
+    {
+        std::lock_guard<std::mutex> guard(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+        /* Count the task before releasing the queue: otherwise, a worker
+           could pop it and decrement the counter first */
+        std::lock_guard<std::mutex> guard2(m_mutex);
+        m_pending++;
+    }
+    m_cond.notify_one();
+}
+
+bool ThreadPool::pop(size_t index, Task &task) {
+    Worker &worker = *m_workers[index];
+    std::lock_guard<std::mutex> guard(worker.mutex);
+    if (worker.tasks.empty())
+        return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t index, Task &task) {
+    for (size_t i = 1; i < m_workers.size(); ++i) {
+        Worker &victim = *m_workers[(index + i) % m_workers.size()];
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (victim.tasks.empty())
+            continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        Task task;
+        if (pop(index, task) || steal(index, task)) {
+            m_pending--;
+            try {
+                task();
+            } catch (const std::exception &e) {
+                std::cerr << "Caught exception in background task: " << e.what() << std::endl;
+            }
+            continue;
+        }
+
+        /* Remaining tasks are still processed after stopping */
+        std::unique_lock<std::mutex> guard(m_mutex);
+        m_cond.wait(guard, [this] { return m_stop || m_pending > 0; });
+        if (m_stop && m_pending == 0)
+            break;
+    }
+
+    current_pool = nullptr;
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end,
+                              const std::function<void(size_t, size_t)> &func,
+                              size_t block_size) {
+    if (end <= begin)
+        return;
+
+    size_t size = end - begin;
+    if (block_size == 0)
+        block_size = std::max((size_t) 1, size / (4 * (m_workers.size() + 1)));
+    size_t blocks = (size + block_size - 1) / block_size;
+
+    struct State {
+        std::atomic<size_t> next { 0 }, done { 0 };
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    /* Helpers that start after all blocks were claimed return immediately
+       and never touch 'func', which only lives until all blocks are done */
+    auto work = [state, begin, end, block_size, blocks, &func] {
+        size_t block;
+        while ((block = state->next++) < blocks) {
+            size_t block_begin = begin + block * block_size,
+                   block_end = std::min(block_begin + block_size, end);
+            try {
+                func(block_begin, block_end);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(state->mutex);
+                if (!state->error)
+                    state->error = std::current_exception();
+            }
+            if (++state->done == blocks) {
+                std::lock_guard<std::mutex> guard(state->mutex);
+                state->cond.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(blocks - 1, m_workers.size());
+    for (size_t i = 0; i < helpers; ++i)
+        enqueue(Task(work));
+
+    /* The calling thread participates, hence nested calls cannot deadlock */
+    work();
+
+    std::unique_lock<std::mutex> guard(state->mutex);
+    state->cond.wait(guard, [&] { return state->done == blocks; });
+    /* Take ownership of the exception: a late helper may release the state */
+    std::exception_ptr error = std::move(state->error);
+    guard.unlock();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+NAMESPACE_END(nanogui)
@@ -16,13 +16,29 @@
 #include <nanogui/opengl.h>
 #include <nanogui/screen.h>
 #include <cassert>
+#include <unordered_map>
+#include <mutex>
 
 NAMESPACE_BEGIN(nanogui)
 
+/* Tooltips of all widgets (allocated once and never destroyed, since
+   widgets may outlive static destruction) */
+struct TooltipTable {
+    std::unordered_map<const Widget *, std::string> tooltips;
+    std::mutex mutex;
+};
+
+static TooltipTable &tooltip_table() {
+    static TooltipTable *table = new TooltipTable();
+    return *table;
+}
+
 Widget::Widget(Widget *parent)
-    : m_parent(nullptr), m_theme(nullptr), m_layout(nullptr),
-      m_pos(0,0), m_size(0,0), m_fixed_size(0,0), m_visible(true), m_enabled(true),
-      m_focused(false), m_mouse_focus(false), m_tooltip(""), m_font_size(-1.f),
+    : m_parent(nullptr), m_pos(0,0), m_size(0,0), m_visible(true), m_enabled(true),
+      m_focused(false), m_mouse_focus(false), m_has_tooltip(false),
+      m_visible_recursive(false), m_cache_valid(false), m_kind(0), m_font_size(-1.f),
+      m_absolute_pos(0, 0), m_window(nullptr), m_screen(nullptr),
+      m_theme(nullptr), m_layout(nullptr), m_fixed_size(0,0),
       m_icon_extra_scale(1.f), m_cursor(Cursor::Arrow) {
     if (parent)
         parent->add_child(this);
@@ -33,6 +49,66 @@ Widget::~Widget() {
         if (child)
             child->dec_ref();
     }
+    if (m_has_tooltip)
+        set_tooltip("");
+}
+
+void Widget::invalidate_cache() {
+    /* A valid cache implies valid caches of all parents (see update_cache()),
+       hence the descendants of an invalid widget need not be visited */
+    if (!m_cache_valid)
+        return;
+    m_cache_valid = false;
+    for (Widget *child : m_children)
+        child->invalidate_cache();
+}
+
+void Widget::update_cache() const {
+    if (m_cache_valid)
+        return;
+    if (m_parent) {
+        m_parent->update_cache();
+        m_absolute_pos = m_parent->m_absolute_pos + m_pos;
+        m_visible_recursive = m_visible && m_parent->m_visible_recursive;
+    } else {
+        m_absolute_pos = m_pos;
+        m_visible_recursive = m_visible;
+    }
+    m_cache_valid = true;
+}
+
+void Widget::update_owners() {
+    Window *window = is_window() ? static_cast<Window *>(this)
+                                 : (m_parent ? m_parent->m_window : nullptr);
+    Screen *screen = is_screen() ? static_cast<Screen *>(this)
+                                 : (m_parent ? m_parent->m_screen : nullptr);
+    if (window == m_window && screen == m_screen)
+        return;
+    m_window = window;
+    m_screen = screen;
+    for (Widget *child : m_children)
+        child->update_owners();
+}
+
+std::string Widget::tooltip() const {
+    if (!m_has_tooltip)
+        return std::string();
+    TooltipTable &table = tooltip_table();
+    std::lock_guard<std::mutex> guard(table.mutex);
+    auto it = table.tooltips.find(this);
+    return it != table.tooltips.end() ? it->second : std::string();
+}
+
+void Widget::set_tooltip(const std::string &tooltip) {
+    if (tooltip.empty() && !m_has_tooltip)
+        return;
+    TooltipTable &table = tooltip_table();
+    std::lock_guard<std::mutex> guard(table.mutex);
+    if (tooltip.empty())
+        table.tooltips.erase(this);
+    else
+        table.tooltips[this] = tooltip;
+    m_has_tooltip = !tooltip.empty();
 }
 
 void Widget::set_theme(Theme *theme) {
@@ -165,6 +241,30 @@ void Widget::add_child(Widget * widget) {
     add_child(child_count(), widget);
 }
 
+void Widget::add_children(int index, Widget *const *widgets, size_t count) {
+    assert(index <= child_count());
+    m_children.insert(m_children.begin() + index, widgets, widgets + count);
+    for (size_t i = 0; i < count; ++i) {
+        Widget *widget = widgets[i];
+        widget->inc_ref();
+        widget->set_parent(this);
+        widget->set_theme(m_theme);
+    }
+}
+
+Widget::BatchBuilder::BatchBuilder(Widget *parent, size_t expected)
+    : m_parent(parent) {
+    parent->m_children.reserve(parent->m_children.size() + expected);
+}
+
+void Widget::BatchBuilder::flush() {
+    if (m_pending.empty())
+        return;
+    m_parent->add_children(m_parent->child_count(), m_pending.data(),
+                           m_pending.size());
+    m_pending.clear();
+}
+
 void Widget::remove_child(const Widget *widget) {
     m_children.erase(std::remove(m_children.begin(), m_children.end(), widget),
                      m_children.end());
@@ -185,36 +285,21 @@ int Widget::child_index(Widget *widget) const {
 }
 
 Window *Widget::window() {
-    Widget *widget = this;
-    while (true) {
-        if (!widget)
-            throw std::runtime_error(
-                "Widget:internal error (could not find parent window)");
-        Window *window = dynamic_cast<Window *>(widget);
-        if (window)
-            return window;
-        widget = widget->parent();
-    }
+    if (!m_window)
+        throw std::runtime_error(
+            "Widget:internal error (could not find parent window)");
+    return m_window;
 }
 
 Screen *Widget::screen() {
-    Widget *widget = this;
-    while (true) {
-        if (!widget)
-            throw std::runtime_error(
-                "Widget:internal error (could not find parent screen)");
-        Screen *screen = dynamic_cast<Screen *>(widget);
-        if (screen)
-            return screen;
-        widget = widget->parent();
-    }
+    if (!m_screen)
+        throw std::runtime_error(
+            "Widget:internal error (could not find parent screen)");
+    return m_screen;
 }
 
 void Widget::request_focus() {
-    Widget *widget = this;
-    while (widget->parent())
-        widget = widget->parent();
-    ((Screen *) widget)->update_focus(this);
+    screen()->update_focus(this);
 }
 
 void Widget::draw(NVGcontext *ctx) {
@@ -20,7 +20,10 @@ NAMESPACE_BEGIN(nanogui)
 
 Window::Window(Widget *parent, const std::string &title)
     : Widget(parent), m_title(title), m_button_panel(nullptr), m_modal(false),
-      m_drag(false) { }
+      m_drag(false) {
+    m_kind |= WindowKind;
+    update_owners();
+}
 
 Vector2i Window::preferred_size(NVGcontext *ctx) const {
     if (m_button_panel)
@@ -29,7 +32,7 @@ Vector2i Window::preferred_size(NVGcontext *ctx) const {
     if (m_button_panel)
         m_button_panel->set_visible(true);
 
-    nvgFontSize(ctx, 18.0f);
+    nvgFontSize(ctx, m_theme->m_window_title_font_size);
     nvgFontFace(ctx, "sans-bold");
     float bounds[4];
     nvgTextBounds(ctx, 0, 0, m_title.c_str(), nullptr, bounds);
@@ -124,11 +127,11 @@ void Window::draw(NVGcontext *ctx) {
         nvgStrokeColor(ctx, m_theme->m_window_header_sep_bot);
         nvgStroke(ctx);
 
-        nvgFontSize(ctx, 18.0f);
+        nvgFontSize(ctx, m_theme->m_window_title_font_size);
         nvgFontFace(ctx, "sans-bold");
         nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
 
-        nvgFontBlur(ctx, 2);
+        nvgFontBlur(ctx, m_theme->m_window_title_shadow_blur);
         nvgFillColor(ctx, m_theme->m_drop_shadow);
         nvgText(ctx, m_pos.x() + m_size.x() / 2,
                 m_pos.y() + hh / 2, m_title.c_str(), nullptr);
@@ -167,10 +170,10 @@ bool Window::mouse_drag_event(const Vector2i &, const Vector2i &rel,
                             int button, int /* modifiers */) {
     if (m_drag && (button & (1 << GLFW_MOUSE_BUTTON_1)) != 0) {
         Vector2i size = parent()->size() - m_size;
-        m_pos = Vector2i(
+        set_position(Vector2i(
             std::min(std::max(m_pos.x() + rel.x(), 0), size.x()),
             std::min(std::max(m_pos.y() + rel.y(), 0), size.y())
-        );
+        ));
         return true;
     }
     return false;